@@ -0,0 +1,785 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "BulkIOImpl.h"
+#include "ThreadPoolImpl.h"
+
+#include <string.h>
+
+#ifdef FECS_BULKIO_SSE2
+# include <emmintrin.h>
+#endif
+#ifdef __F16C__
+# include <immintrin.h>
+#endif
+
+using namespace FabricSpliceImpl;
+
+// element sizes which fit a native type are copied with plain loads and
+// stores instead of going through memcpy for every element.
+struct BulkIOElement12 { uint32_t v[3]; };
+
+template<typename T>
+static void packStridedTyped(void * target, const void * source, uint32_t count, uint32_t sourceStride)
+{
+  T * dst = (T*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += sourceStride)
+    memcpy(&dst[i], src, sizeof(T));
+}
+
+template<typename T>
+static void unpackStridedTyped(void * target, const void * source, uint32_t count, uint32_t targetStride)
+{
+  char * dst = (char*)target;
+  const T * src = (const T*)source;
+  for(uint32_t i=0;i<count;i++, dst += targetStride)
+    memcpy(dst, &src[i], sizeof(T));
+}
+
+#ifdef FECS_BULKIO_SSE2
+
+// packs Vec3 style elements from a source with a stride of at least 16 bytes,
+// four elements at a time using three unaligned stores.
+static uint32_t packStrided12SSE2(void * target, const void * source, uint32_t count, uint32_t sourceStride)
+{
+  if(sourceStride < 16)
+    return 0;
+
+  float * dst = (float*)target;
+  const char * src = (const char*)source;
+  uint32_t i = 0;
+
+  // the last element is left to the scalar loop so that the
+  // 16 byte loads never read past the end of the source buffer
+  for(;i+4<count;i+=4)
+  {
+    __m128 a = _mm_loadu_ps((const float*)(src));
+    __m128 b = _mm_loadu_ps((const float*)(src + sourceStride));
+    __m128 c = _mm_loadu_ps((const float*)(src + 2 * sourceStride));
+    __m128 d = _mm_loadu_ps((const float*)(src + 3 * sourceStride));
+
+    __m128 azbx = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 2));
+    __m128 czdx = _mm_shuffle_ps(c, d, _MM_SHUFFLE(0, 0, 2, 2));
+
+    _mm_storeu_ps(dst, _mm_shuffle_ps(a, azbx, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 1)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(czdx, d, _MM_SHUFFLE(2, 1, 2, 0)));
+
+    dst += 12;
+    src += 4 * sourceStride;
+  }
+  return i;
+}
+
+// unpacks tightly packed Vec3 style elements, four elements at a time.
+// only 12 bytes are written per element so padding and interleaved
+// attributes in the target remain untouched.
+static uint32_t unpackStrided12SSE2(void * target, const void * source, uint32_t count, uint32_t targetStride)
+{
+  char * dst = (char*)target;
+  const float * src = (const float*)source;
+  uint32_t i = 0;
+
+  for(;i+4<=count;i+=4)
+  {
+    __m128 p0 = _mm_loadu_ps(src);
+    __m128 p1 = _mm_loadu_ps(src + 4);
+    __m128 p2 = _mm_loadu_ps(src + 8);
+
+    __m128 bxby = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 3, 3));
+    __m128 v[4];
+    v[0] = p0;
+    v[1] = _mm_shuffle_ps(bxby, bxby, _MM_SHUFFLE(3, 3, 2, 0));
+    v[2] = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(0, 0, 3, 2));
+    v[3] = _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 2, 1));
+
+    for(uint32_t j=0;j<4;j++)
+    {
+      _mm_storel_pi((__m64*)dst, v[j]);
+      _mm_store_ss((float*)(dst + 8), _mm_movehl_ps(v[j], v[j]));
+      dst += targetStride;
+    }
+    src += 12;
+  }
+  return i;
+}
+
+static void packStrided16SSE2(void * target, const void * source, uint32_t count, uint32_t sourceStride)
+{
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += sourceStride, dst += 16)
+    _mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+}
+
+static void unpackStrided16SSE2(void * target, const void * source, uint32_t count, uint32_t targetStride)
+{
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += 16, dst += targetStride)
+    _mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+}
+
+#endif
+
+void BulkIOImpl::packStrided(
+  void * target,
+  const void * source,
+  uint32_t count,
+  uint32_t elementSize,
+  uint32_t sourceStride
+  )
+{
+  if(count == 0 || elementSize == 0)
+    return;
+
+  if(sourceStride == elementSize)
+  {
+    memcpy(target, source, (size_t)count * elementSize);
+    return;
+  }
+
+  switch(elementSize)
+  {
+    case 4:
+      packStridedTyped<uint32_t>(target, source, count, sourceStride);
+      return;
+    case 8:
+      packStridedTyped<uint64_t>(target, source, count, sourceStride);
+      return;
+    case 12:
+    {
+      uint32_t done = 0;
+#ifdef FECS_BULKIO_SSE2
+      done = packStrided12SSE2(target, source, count, sourceStride);
+#endif
+      packStridedTyped<BulkIOElement12>(
+        (char*)target + (size_t)done * 12,
+        (const char*)source + (size_t)done * sourceStride,
+        count - done,
+        sourceStride
+        );
+      return;
+    }
+#ifdef FECS_BULKIO_SSE2
+    case 16:
+      packStrided16SSE2(target, source, count, sourceStride);
+      return;
+#endif
+    default:
+      break;
+  }
+
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += sourceStride, dst += elementSize)
+    memcpy(dst, src, elementSize);
+}
+
+void BulkIOImpl::unpackStrided(
+  void * target,
+  const void * source,
+  uint32_t count,
+  uint32_t elementSize,
+  uint32_t targetStride
+  )
+{
+  if(count == 0 || elementSize == 0)
+    return;
+
+  if(targetStride == elementSize)
+  {
+    memcpy(target, source, (size_t)count * elementSize);
+    return;
+  }
+
+  switch(elementSize)
+  {
+    case 4:
+      unpackStridedTyped<uint32_t>(target, source, count, targetStride);
+      return;
+    case 8:
+      unpackStridedTyped<uint64_t>(target, source, count, targetStride);
+      return;
+    case 12:
+    {
+      uint32_t done = 0;
+#ifdef FECS_BULKIO_SSE2
+      done = unpackStrided12SSE2(target, source, count, targetStride);
+#endif
+      unpackStridedTyped<BulkIOElement12>(
+        (char*)target + (size_t)done * targetStride,
+        (const char*)source + (size_t)done * 12,
+        count - done,
+        targetStride
+        );
+      return;
+    }
+#ifdef FECS_BULKIO_SSE2
+    case 16:
+      unpackStrided16SSE2(target, source, count, targetStride);
+      return;
+#endif
+    default:
+      break;
+  }
+
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += elementSize, dst += targetStride)
+    memcpy(dst, src, elementSize);
+}
+
+uint32_t BulkIOImpl::getDataFormatSize(DataFormat format)
+{
+  switch(format)
+  {
+    case DataFormat_Float32:
+      return 4;
+    case DataFormat_Float64:
+      return 8;
+    case DataFormat_Float16:
+      return 2;
+  }
+  return 0;
+}
+
+void BulkIOImpl::convertToFloat32(float * target, const void * source, DataFormat format, uint32_t count)
+{
+  uint32_t i = 0;
+  if(format == DataFormat_Float32)
+  {
+    memcpy(target, source, (size_t)count * 4);
+  }
+  else if(format == DataFormat_Float64)
+  {
+    const double * src = (const double*)source;
+#ifdef FECS_BULKIO_SSE2
+    for(;i+4<=count;i+=4)
+    {
+      __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+      __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+      _mm_storeu_ps(target + i, _mm_movelh_ps(lo, hi));
+    }
+#endif
+    for(;i<count;i++)
+      target[i] = (float)src[i];
+  }
+  else if(format == DataFormat_Float16)
+  {
+    const uint16_t * src = (const uint16_t*)source;
+#ifdef __F16C__
+    for(;i+8<=count;i+=8)
+    {
+      __m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+      _mm_storeu_ps(target + i, _mm_cvtph_ps(h));
+      _mm_storeu_ps(target + i + 4, _mm_cvtph_ps(_mm_srli_si128(h, 8)));
+    }
+#endif
+    for(;i<count;i++)
+      target[i] = float16ToFloat32(src[i]);
+  }
+}
+
+void BulkIOImpl::convertFromFloat32(void * target, DataFormat format, const float * source, uint32_t count)
+{
+  uint32_t i = 0;
+  if(format == DataFormat_Float32)
+  {
+    memcpy(target, source, (size_t)count * 4);
+  }
+  else if(format == DataFormat_Float64)
+  {
+    double * dst = (double*)target;
+#ifdef FECS_BULKIO_SSE2
+    for(;i+4<=count;i+=4)
+    {
+      __m128 f = _mm_loadu_ps(source + i);
+      _mm_storeu_pd(dst + i, _mm_cvtps_pd(f));
+      _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+    }
+#endif
+    for(;i<count;i++)
+      dst[i] = (double)source[i];
+  }
+  else if(format == DataFormat_Float16)
+  {
+    uint16_t * dst = (uint16_t*)target;
+#ifdef __F16C__
+    for(;i+4<=count;i+=4)
+      _mm_storel_epi64((__m128i*)(dst + i), _mm_cvtps_ph(_mm_loadu_ps(source + i), 0));
+#endif
+    for(;i<count;i++)
+      dst[i] = float32ToFloat16(source[i]);
+  }
+}
+
+// writes a single row major Float32 matrix in the given order and format
+static inline void storeMat44(void * target, BulkIOImpl::DataFormat format, BulkIOImpl::MatrixOrder order, const float * m)
+{
+#ifdef FECS_BULKIO_SSE2
+  if(format != BulkIOImpl::DataFormat_Float16)
+  {
+    __m128 r0 = _mm_loadu_ps(m);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+    if(order == BulkIOImpl::MatrixOrder_ColumnMajor)
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    if(format == BulkIOImpl::DataFormat_Float32)
+    {
+      float * dst = (float*)target;
+      _mm_storeu_ps(dst, r0);
+      _mm_storeu_ps(dst + 4, r1);
+      _mm_storeu_ps(dst + 8, r2);
+      _mm_storeu_ps(dst + 12, r3);
+    }
+    else
+    {
+      double * dst = (double*)target;
+      _mm_storeu_pd(dst, _mm_cvtps_pd(r0));
+      _mm_storeu_pd(dst + 2, _mm_cvtps_pd(_mm_movehl_ps(r0, r0)));
+      _mm_storeu_pd(dst + 4, _mm_cvtps_pd(r1));
+      _mm_storeu_pd(dst + 6, _mm_cvtps_pd(_mm_movehl_ps(r1, r1)));
+      _mm_storeu_pd(dst + 8, _mm_cvtps_pd(r2));
+      _mm_storeu_pd(dst + 10, _mm_cvtps_pd(_mm_movehl_ps(r2, r2)));
+      _mm_storeu_pd(dst + 12, _mm_cvtps_pd(r3));
+      _mm_storeu_pd(dst + 14, _mm_cvtps_pd(_mm_movehl_ps(r3, r3)));
+    }
+    return;
+  }
+#endif
+  float t[16];
+  if(order == BulkIOImpl::MatrixOrder_ColumnMajor)
+  {
+    for(uint32_t r=0;r<4;r++)
+      for(uint32_t c=0;c<4;c++)
+        t[c * 4 + r] = m[r * 4 + c];
+    m = t;
+  }
+  BulkIOImpl::convertFromFloat32(target, format, m, 16);
+}
+
+void BulkIOImpl::convertFromMat44(void * target, DataFormat format, MatrixOrder order, const float * source, uint32_t count)
+{
+  if(order == MatrixOrder_RowMajor)
+  {
+    convertFromFloat32(target, format, source, count * 16);
+    return;
+  }
+  uint32_t matrixSize = 16 * getDataFormatSize(format);
+  for(uint32_t i=0;i<count;i++)
+    storeMat44((char*)target + (size_t)i * matrixSize, format, order, source + (size_t)i * 16);
+}
+
+void BulkIOImpl::convertToMat44(float * target, const void * source, DataFormat format, MatrixOrder order, uint32_t count)
+{
+  convertToFloat32(target, source, format, count * 16);
+  if(order == MatrixOrder_RowMajor)
+    return;
+
+  // transpose in place
+  uint32_t i = 0;
+#ifdef FECS_BULKIO_SSE2
+  for(;i<count;i++)
+  {
+    float * m = target + (size_t)i * 16;
+    __m128 r0 = _mm_loadu_ps(m);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(m, r0);
+    _mm_storeu_ps(m + 4, r1);
+    _mm_storeu_ps(m + 8, r2);
+    _mm_storeu_ps(m + 12, r3);
+  }
+#endif
+  for(;i<count;i++)
+  {
+    float * m = target + (size_t)i * 16;
+    for(uint32_t r=0;r<4;r++)
+    {
+      for(uint32_t c=r+1;c<4;c++)
+      {
+        float v = m[r * 4 + c];
+        m[r * 4 + c] = m[c * 4 + r];
+        m[c * 4 + r] = v;
+      }
+    }
+  }
+}
+
+void BulkIOImpl::convertFromXfo(void * target, DataFormat format, MatrixOrder order, const float * source, uint32_t count)
+{
+  uint32_t matrixSize = 16 * getDataFormatSize(format);
+  for(uint32_t i=0;i<count;i++)
+  {
+    // ori.v.x, ori.v.y, ori.v.z, ori.w, tr.x, tr.y, tr.z, sc.x, sc.y, sc.z
+    const float * xfo = source + (size_t)i * 10;
+    float x = xfo[0], y = xfo[1], z = xfo[2], w = xfo[3];
+    float xx = x * x, yy = y * y, zz = z * z;
+    float xy = x * y, xz = x * z, yz = y * z;
+    float xw = x * w, yw = y * w, zw = z * w;
+
+    // translation * rotation * scaling, like Xfo.toMat44()
+    float m[16];
+    m[0] = (1.0f - 2.0f * (yy + zz)) * xfo[7];
+    m[1] = 2.0f * (xy - zw) * xfo[8];
+    m[2] = 2.0f * (xz + yw) * xfo[9];
+    m[3] = xfo[4];
+    m[4] = 2.0f * (xy + zw) * xfo[7];
+    m[5] = (1.0f - 2.0f * (xx + zz)) * xfo[8];
+    m[6] = 2.0f * (yz - xw) * xfo[9];
+    m[7] = xfo[5];
+    m[8] = 2.0f * (xz - yw) * xfo[7];
+    m[9] = 2.0f * (yz + xw) * xfo[8];
+    m[10] = (1.0f - 2.0f * (xx + yy)) * xfo[9];
+    m[11] = xfo[6];
+    m[12] = 0.0f;
+    m[13] = 0.0f;
+    m[14] = 0.0f;
+    m[15] = 1.0f;
+    storeMat44((char*)target + (size_t)i * matrixSize, format, order, m);
+  }
+}
+
+float BulkIOImpl::float16ToFloat32(uint16_t value)
+{
+  uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1f;
+  uint32_t mantissa = value & 0x3ff;
+  uint32_t bits;
+
+  if(exponent == 0)
+  {
+    if(mantissa == 0)
+      bits = sign;
+    else
+    {
+      // subnormal, renormalize into a Float32 normal
+      int e = 1;
+      while((mantissa & 0x400) == 0)
+      {
+        mantissa <<= 1;
+        e--;
+      }
+      mantissa &= 0x3ff;
+      bits = sign | ((uint32_t)(e + 112) << 23) | (mantissa << 13);
+    }
+  }
+  else if(exponent == 31)
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  else
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+  float result;
+  memcpy(&result, &bits, 4);
+  return result;
+}
+
+uint16_t BulkIOImpl::float32ToFloat16(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, 4);
+  uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+  uint32_t absBits = bits & 0x7fffffff;
+
+  // infinity and NaN
+  if(absBits >= 0x7f800000)
+    return sign | (absBits > 0x7f800000 ? 0x7e00 : 0x7c00);
+  // rounds to infinity
+  if(absBits >= 0x477ff000)
+    return sign | 0x7c00;
+
+  // subnormal results
+  if(absBits < 0x38800000)
+  {
+    if(absBits <= 0x33000000)
+      return sign;
+    uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+    uint32_t shift = 126 - (absBits >> 23);
+    uint32_t result = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if(remainder > halfway || (remainder == halfway && (result & 1)))
+      result++;
+    return sign | (uint16_t)result;
+  }
+
+  uint32_t result = (absBits - 0x38000000) >> 13;
+  uint32_t remainder = absBits & 0x1fff;
+  if(remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+    result++;
+  return sign | (uint16_t)result;
+}
+
+template<typename T>
+static void gatherIndexedTyped(void * target, const void * source, const uint32_t * indices, uint32_t count)
+{
+  T * dst = (T*)target;
+  const T * src = (const T*)source;
+  uint32_t i = 0;
+  for(;i+4<=count;i+=4)
+  {
+    T a = src[indices[i]];
+    T b = src[indices[i+1]];
+    T c = src[indices[i+2]];
+    T d = src[indices[i+3]];
+    dst[i] = a;
+    dst[i+1] = b;
+    dst[i+2] = c;
+    dst[i+3] = d;
+  }
+  for(;i<count;i++)
+    dst[i] = src[indices[i]];
+}
+
+template<typename T>
+static void scatterIndexedTyped(void * target, const void * source, const uint32_t * indices, uint32_t count)
+{
+  // stores stay in order so that duplicate indices resolve to the last element
+  T * dst = (T*)target;
+  const T * src = (const T*)source;
+  for(uint32_t i=0;i<count;i++)
+    dst[indices[i]] = src[i];
+}
+
+#ifdef FECS_BULKIO_SSE2
+
+static void gatherIndexed16SSE2(void * target, const void * source, const uint32_t * indices, uint32_t count)
+{
+  __m128i * dst = (__m128i*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++)
+    _mm_storeu_si128(&dst[i], _mm_loadu_si128((const __m128i*)(src + (size_t)indices[i] * 16)));
+}
+
+static void scatterIndexed16SSE2(void * target, const void * source, const uint32_t * indices, uint32_t count)
+{
+  char * dst = (char*)target;
+  const __m128i * src = (const __m128i*)source;
+  for(uint32_t i=0;i<count;i++)
+    _mm_storeu_si128((__m128i*)(dst + (size_t)indices[i] * 16), _mm_loadu_si128(&src[i]));
+}
+
+#endif
+
+void BulkIOImpl::gatherIndexed(
+  void * target,
+  const void * source,
+  const uint32_t * indices,
+  uint32_t count,
+  uint32_t elementSize
+  )
+{
+  if(count == 0 || elementSize == 0)
+    return;
+
+  switch(elementSize)
+  {
+    case 4:
+      gatherIndexedTyped<uint32_t>(target, source, indices, count);
+      return;
+    case 8:
+      gatherIndexedTyped<uint64_t>(target, source, indices, count);
+      return;
+    case 12:
+      gatherIndexedTyped<BulkIOElement12>(target, source, indices, count);
+      return;
+#ifdef FECS_BULKIO_SSE2
+    case 16:
+      gatherIndexed16SSE2(target, source, indices, count);
+      return;
+#endif
+    default:
+      break;
+  }
+
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, dst += elementSize)
+    memcpy(dst, src + (size_t)indices[i] * elementSize, elementSize);
+}
+
+void BulkIOImpl::scatterIndexed(
+  void * target,
+  const void * source,
+  const uint32_t * indices,
+  uint32_t count,
+  uint32_t elementSize
+  )
+{
+  if(count == 0 || elementSize == 0)
+    return;
+
+  switch(elementSize)
+  {
+    case 4:
+      scatterIndexedTyped<uint32_t>(target, source, indices, count);
+      return;
+    case 8:
+      scatterIndexedTyped<uint64_t>(target, source, indices, count);
+      return;
+    case 12:
+      scatterIndexedTyped<BulkIOElement12>(target, source, indices, count);
+      return;
+#ifdef FECS_BULKIO_SSE2
+    case 16:
+      scatterIndexed16SSE2(target, source, indices, count);
+      return;
+#endif
+    default:
+      break;
+  }
+
+  char * dst = (char*)target;
+  const char * src = (const char*)source;
+  for(uint32_t i=0;i<count;i++, src += elementSize)
+    memcpy(dst + (size_t)indices[i] * elementSize, src, elementSize);
+}
+
+uint32_t BulkIOImpl::getMaxIndex(const uint32_t * indices, uint32_t count)
+{
+  uint32_t result = 0;
+  uint32_t i = 0;
+
+#ifdef FECS_BULKIO_SSE2
+  if(count >= 8)
+  {
+    // SSE2 only has a signed compare, so the sign bit is flipped on
+    // the way in and out to get an unsigned maximum.
+    const __m128i bias = _mm_set1_epi32((int)0x80000000);
+    __m128i maxVal = _mm_xor_si128(_mm_loadu_si128((const __m128i*)indices), bias);
+    for(i=4;i+4<=count;i+=4)
+    {
+      __m128i val = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(indices + i)), bias);
+      __m128i greater = _mm_cmpgt_epi32(val, maxVal);
+      maxVal = _mm_or_si128(_mm_and_si128(greater, val), _mm_andnot_si128(greater, maxVal));
+    }
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(maxVal, bias));
+    for(uint32_t j=0;j<4;j++)
+    {
+      if(lanes[j] > result)
+        result = lanes[j];
+    }
+  }
+#endif
+
+  for(;i<count;i++)
+  {
+    if(indices[i] > result)
+      result = indices[i];
+  }
+  return result;
+}
+
+uint64_t BulkIOImpl::getStridedSpan(uint32_t count, uint32_t elementSize, uint32_t stride, uint32_t offset)
+{
+  if(count == 0)
+    return 0;
+  return (uint64_t)offset + (uint64_t)(count - 1) * stride + elementSize;
+}
+
+static bool sParallelCopyEnabled = false;
+static uint64_t sParallelCopyThreshold = 16 * 1024 * 1024;
+static bool sParallelCopyNonTemporal = false;
+
+// the smallest chunk a parallel copy is split into
+static const uint64_t sParallelCopyChunkSize = 1024 * 1024;
+
+static void copyChunk(char * dst, const char * src, uint64_t size, bool nonTemporal)
+{
+#ifdef FECS_BULKIO_SSE2
+  if(nonTemporal && size >= 64)
+  {
+    // streaming stores need an aligned target, the head and tail are copied regularly
+    uint64_t head = (16 - ((size_t)dst & 15)) & 15;
+    memcpy(dst, src, (size_t)head);
+    dst += head;
+    src += head;
+    size -= head;
+
+    uint64_t blocks = size / 64;
+    for(uint64_t i=0;i<blocks;i++, dst += 64, src += 64)
+    {
+      __m128i a = _mm_loadu_si128((const __m128i*)(src));
+      __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+      __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+      __m128i d = _mm_loadu_si128((const __m128i*)(src + 48));
+      _mm_stream_si128((__m128i*)(dst), a);
+      _mm_stream_si128((__m128i*)(dst + 16), b);
+      _mm_stream_si128((__m128i*)(dst + 32), c);
+      _mm_stream_si128((__m128i*)(dst + 48), d);
+    }
+    memcpy(dst, src, (size_t)(size - blocks * 64));
+
+    // make the streamed data visible before the task reports completion
+    _mm_sfence();
+    return;
+  }
+#else
+  (void)nonTemporal;
+#endif
+  memcpy(dst, src, (size_t)size);
+}
+
+struct ParallelCopyTask
+{
+  char * target;
+  const char * source;
+  uint64_t size;
+  uint64_t chunkSize;
+  bool nonTemporal;
+};
+
+static void parallelCopyTask(void * userData, uint32_t index)
+{
+  ParallelCopyTask * task = (ParallelCopyTask *)userData;
+  uint64_t offset = (uint64_t)index * task->chunkSize;
+  uint64_t size = task->size - offset;
+  if(size > task->chunkSize)
+    size = task->chunkSize;
+  copyChunk(task->target + offset, task->source + offset, size, task->nonTemporal);
+}
+
+void BulkIOImpl::setParallelCopy(bool enabled, uint32_t threadCount, uint64_t threshold, bool nonTemporal)
+{
+  sParallelCopyEnabled = enabled;
+  sParallelCopyThreshold = threshold;
+  sParallelCopyNonTemporal = nonTemporal;
+  ThreadPoolImpl::setThreadCount(threadCount);
+}
+
+bool BulkIOImpl::isParallelCopy(uint64_t size)
+{
+  return sParallelCopyEnabled && size >= sParallelCopyThreshold && size >= 2 * sParallelCopyChunkSize;
+}
+
+void BulkIOImpl::copy(void * target, const void * source, uint64_t size)
+{
+  if(size == 0)
+    return;
+  if(!isParallelCopy(size))
+  {
+    copyChunk((char*)target, (const char*)source, size, false);
+    return;
+  }
+
+  // one chunk per thread, cache line aligned so that no two
+  // threads write into the same line
+  uint64_t threadCount = ThreadPoolImpl::getThreadCount();
+  uint64_t chunkSize = (size + threadCount - 1) / threadCount;
+  chunkSize = (chunkSize + 63) & ~(uint64_t)63;
+  if(chunkSize < sParallelCopyChunkSize)
+    chunkSize = sParallelCopyChunkSize;
+
+  ParallelCopyTask task;
+  task.target = (char*)target;
+  task.source = (const char*)source;
+  task.size = size;
+  task.chunkSize = chunkSize;
+  task.nonTemporal = sParallelCopyNonTemporal;
+  ThreadPoolImpl::run(parallelCopyTask, &task, (uint32_t)((size + chunkSize - 1) / chunkSize));
+}
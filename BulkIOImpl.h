@@ -0,0 +1,120 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_BULKIOIMPL_H__
+#define __FabricSpliceImpl_BULKIOIMPL_H__
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define FECS_BULKIO_SSE2
+#endif
+
+namespace FabricSpliceImpl
+{
+  /// copy kernels used by the high performance IO to move elements
+  /// between host buffers and the FabricCore member storage.
+  class BulkIOImpl
+  {
+  public:
+
+    /// the scalar format of host buffers passed to the converting IO
+    enum DataFormat
+    {
+      DataFormat_Float32,
+      DataFormat_Float64,
+      DataFormat_Float16
+    };
+
+    /// the element order of 4x4 matrices in host buffers. KL's Mat44 is row major,
+    /// column major matrices hold the translation in elements 12 to 14.
+    enum MatrixOrder
+    {
+      MatrixOrder_RowMajor,
+      MatrixOrder_ColumnMajor
+    };
+
+    /// copies count elements from a strided source into a tightly packed target.
+    /// element i is read from source + i * sourceStride.
+    static void packStrided(
+      void * target,
+      const void * source,
+      uint32_t count,
+      uint32_t elementSize,
+      uint32_t sourceStride
+      );
+
+    /// copies count elements from a tightly packed source into a strided target.
+    /// element i is written to target + i * targetStride, bytes in between
+    /// the elements are left untouched.
+    static void unpackStrided(
+      void * target,
+      const void * source,
+      uint32_t count,
+      uint32_t elementSize,
+      uint32_t targetStride
+      );
+
+    /// copies the elements at the given indices of source into a tightly packed target.
+    /// the indices are not validated, see getMaxIndex.
+    static void gatherIndexed(
+      void * target,
+      const void * source,
+      const uint32_t * indices,
+      uint32_t count,
+      uint32_t elementSize
+      );
+
+    /// copies tightly packed elements from source to the given indices of target.
+    /// for duplicate indices the last element wins.
+    static void scatterIndexed(
+      void * target,
+      const void * source,
+      const uint32_t * indices,
+      uint32_t count,
+      uint32_t elementSize
+      );
+
+    /// returns the largest of count indices, or 0 if count is 0
+    static uint32_t getMaxIndex(const uint32_t * indices, uint32_t count);
+
+    /// configures the parallel copy used for large transfers. copies of at least
+    /// threshold bytes are split across threadCount host threads (0 uses the
+    /// number of hardware threads). nonTemporal uses streaming stores which
+    /// bypass the cache, for targets which aren't read again right away.
+    static void setParallelCopy(bool enabled, uint32_t threadCount, uint64_t threshold, bool nonTemporal);
+
+    /// returns true if a copy of the given size is split across threads
+    static bool isParallelCopy(uint64_t size);
+
+    /// copies size bytes, using the parallel copy for large sizes
+    static void copy(void * target, const void * source, uint64_t size);
+
+    /// returns the number of bytes a strided buffer of count elements spans
+    static uint64_t getStridedSpan(uint32_t count, uint32_t elementSize, uint32_t stride, uint32_t offset);
+
+    /// returns the byte size of a single scalar of the given format
+    static uint32_t getDataFormatSize(DataFormat format);
+
+    /// converts count scalars of the given format into Float32
+    static void convertToFloat32(float * target, const void * source, DataFormat format, uint32_t count);
+
+    /// converts count Float32 scalars into the given format
+    static void convertFromFloat32(void * target, DataFormat format, const float * source, uint32_t count);
+
+    /// converts count Mat44 into matrices of the given order and format
+    static void convertFromMat44(void * target, DataFormat format, MatrixOrder order, const float * source, uint32_t count);
+
+    /// converts count matrices of the given order and format into Mat44
+    static void convertToMat44(float * target, const void * source, DataFormat format, MatrixOrder order, uint32_t count);
+
+    /// converts count Xfo (ori, tr, sc) into matrices of the given order and format,
+    /// matching KL's Xfo.toMat44()
+    static void convertFromXfo(void * target, DataFormat format, MatrixOrder order, const float * source, uint32_t count);
+
+    /// scalar Float16 conversion, rounding to nearest even
+    static float float16ToFloat32(uint16_t value);
+    static uint16_t float32ToFloat16(float value);
+  };
+};
+
+#endif
@@ -0,0 +1,485 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "ColumnLayoutImpl.h"
+#include "TypeLayoutImpl.h"
+#include "StringUtilityImpl.h"
+#include "DGGraphImpl.h"
+
+#include <string.h>
+#include <limits.h>
+#include <algorithm>
+
+using namespace FabricSpliceImpl;
+
+std::map<std::string, ColumnLayoutImplPtr> ColumnLayoutImpl::sLayouts;
+boost::mutex ColumnLayoutImpl::sLayoutsMutex;
+
+ColumnLayoutImpl::ColumnLayoutImpl(const std::string & dataType)
+{
+  mDataType = dataType;
+}
+
+ColumnLayoutImplPtr ColumnLayoutImpl::getLayout(const std::string & dataType, std::string * errorOut)
+{
+  boost::unique_lock<boost::mutex> lock(sLayoutsMutex);
+  std::map<std::string, ColumnLayoutImplPtr>::iterator it = sLayouts.find(dataType);
+  if(it != sLayouts.end())
+    return it->second;
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  if(client == NULL)
+  {
+    LoggingImpl::reportError("No FabricCore client constructed.", errorOut);
+    return ColumnLayoutImplPtr();
+  }
+
+  ColumnLayoutImplPtr layout(new ColumnLayoutImpl(dataType));
+  Node root;
+  root.dataType = dataType;
+  root.column = -1;
+  root.firstColumn = 0;
+  root.endColumn = 0;
+  try
+  {
+    root.isObject = FabricCore::GetRegisteredTypeIsObject(*client, dataType.c_str());
+  }
+  catch(FabricCore::Exception e)
+  {
+    LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+    return ColumnLayoutImplPtr();
+  }
+  layout->mNodes.push_back(root);
+
+  stringVector typeStack;
+  typeStack.push_back(dataType);
+  if(!layout->appendMembers(0, "", typeStack, 0, errorOut))
+    return ColumnLayoutImplPtr();
+  if(layout->mColumns.size() == 0)
+  {
+    LoggingImpl::reportError("Type '"+dataType+"' has no members which can be flattened into columns.", errorOut);
+    return ColumnLayoutImplPtr();
+  }
+
+  sLayouts.insert(std::pair<std::string, ColumnLayoutImplPtr>(dataType, layout));
+  return layout;
+}
+
+void ColumnLayoutImpl::clearCache()
+{
+  boost::unique_lock<boost::mutex> lock(sLayoutsMutex);
+  sLayouts.clear();
+}
+
+int ColumnLayoutImpl::getColumnIndex(const std::string & path) const
+{
+  std::map<std::string, uint32_t>::const_iterator it = mColumnIndices.find(path);
+  if(it == mColumnIndices.end())
+    return -1;
+  return (int)it->second;
+}
+
+FabricCore::Variant ColumnLayoutImpl::getSchema() const
+{
+  FabricCore::Variant result = FabricCore::Variant::CreateArray();
+  for(size_t i=0;i<mColumns.size();i++)
+  {
+    const Column & column = mColumns[i];
+    FabricCore::Variant columnVar = FabricCore::Variant::CreateDict();
+    columnVar.setDictValue("path", FabricCore::Variant::CreateString(column.path.c_str()));
+    columnVar.setDictValue("dataType", FabricCore::Variant::CreateString(column.dataType.c_str()));
+    columnVar.setDictValue("elementSize", FabricCore::Variant::CreateUInt32(column.elementSize));
+    columnVar.setDictValue("variable", FabricCore::Variant::CreateBoolean(column.type != ColumnType_Shallow));
+    result.arrayAppend(columnVar);
+  }
+  return result;
+}
+
+bool ColumnLayoutImpl::read(std::vector<FabricCore::RTVal> & elements, std::vector<Buffer*> & buffers, std::string * errorOut)
+{
+  Transfer transfer;
+  transfer.buffers = &buffers;
+  transfer.writing = false;
+  transfer.errorOut = errorOut;
+
+  try
+  {
+    uint32_t count = (uint32_t)elements.size();
+    if(!beginTransfer(count, transfer))
+      return false;
+
+    for(uint32_t i=0;i<count;i++)
+    {
+      transfer.element = i;
+      if(!transferNode(0, elements[i], transfer))
+        return false;
+    }
+
+    // the shallow columns were gathered in a KL array, so each of them is a single copy
+    for(size_t i=0;i<mColumns.size();i++)
+    {
+      Buffer * buffer = buffers[i];
+      if(buffer == NULL)
+        continue;
+      if(mColumns[i].type == ColumnType_Shallow)
+      {
+        if(count > 0)
+          memcpy(buffer->data, transfer.staging[i].callMethod("Data", "data", 0, 0).getData(), buffer->dataSize);
+      }
+      else if(buffer->data != NULL && transfer.cursors[i] * mColumns[i].elementSize != buffer->dataSize)
+        return LoggingImpl::reportError("The data size of column '"+mColumns[i].path+"' does not match its offsets.", errorOut);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+bool ColumnLayoutImpl::write(std::vector<FabricCore::RTVal> & elements, std::vector<Buffer*> & buffers, std::string * errorOut)
+{
+  Transfer transfer;
+  transfer.buffers = &buffers;
+  transfer.writing = true;
+  transfer.errorOut = errorOut;
+
+  try
+  {
+    uint32_t count = (uint32_t)elements.size();
+    if(!beginTransfer(count, transfer))
+      return false;
+
+    for(uint32_t i=0;i<count;i++)
+    {
+      transfer.element = i;
+      if(!transferNode(0, elements[i], transfer))
+        return false;
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+bool ColumnLayoutImpl::appendMembers(uint32_t nodeIndex, const std::string & prefix, stringVector & typeStack, int depth, std::string * errorOut)
+{
+  if(depth > 32)
+    return LoggingImpl::reportError("Type '"+mDataType+"' is nested too deeply.", errorOut);
+
+  stringVector memberTypes;
+  stringVector memberNames;
+  if(!TypeLayoutImpl::getStructMembers(mNodes[nodeIndex].dataType, memberTypes, memberNames, true))
+  {
+    if(nodeIndex == 0)
+      return LoggingImpl::reportError("The members of type '"+mDataType+"' are unknown.", errorOut);
+    // nested types we don't know the members of are left out
+    return true;
+  }
+
+  mNodes[nodeIndex].firstColumn = (uint32_t)mColumns.size();
+  for(size_t i=0;i<memberTypes.size();i++)
+  {
+    const std::string & memberType = memberTypes[i];
+    std::string path = prefix.length() > 0 ? prefix + "." + memberNames[i] : memberNames[i];
+
+    Node child;
+    child.name = memberNames[i];
+    child.dataType = memberType;
+    child.isObject = false;
+    child.column = -1;
+    child.firstColumn = 0;
+    child.endColumn = 0;
+
+    Column column;
+    column.path = path;
+    column.elementSize = 0;
+    if(StringUtilityImpl::endsWith(memberType, "[]"))
+    {
+      // only variable arrays of shallow types are flattened
+      column.dataType = memberType.substr(0, memberType.length() - 2);
+      column.type = ColumnType_Array;
+      if(!getShallowSize(column.dataType, column.elementSize))
+        continue;
+    }
+    else if(memberType == "String")
+    {
+      column.dataType = memberType;
+      column.type = ColumnType_String;
+      column.elementSize = 1;
+    }
+    else if(getShallowSize(memberType, column.elementSize))
+    {
+      column.dataType = memberType;
+      column.type = ColumnType_Shallow;
+    }
+    else
+    {
+      // dictionaries, fixed arrays of non shallow types and
+      // recursive object references can't be flattened
+      if(memberType.find('[') != std::string::npos)
+        continue;
+      if(std::find(typeStack.begin(), typeStack.end(), memberType) != typeStack.end())
+        continue;
+
+      try
+      {
+        child.isObject = FabricCore::GetRegisteredTypeIsObject(*DGGraphImpl::getClient(), memberType.c_str());
+      }
+      catch(FabricCore::Exception e)
+      {
+        continue;
+      }
+
+      uint32_t childIndex = (uint32_t)mNodes.size();
+      mNodes.push_back(child);
+      typeStack.push_back(memberType);
+      bool result = appendMembers(childIndex, path, typeStack, depth + 1, errorOut);
+      typeStack.pop_back();
+      if(!result)
+        return false;
+      if(mNodes[childIndex].firstColumn == mNodes[childIndex].endColumn)
+      {
+        mNodes.resize(childIndex);
+        continue;
+      }
+      mNodes[nodeIndex].children.push_back(childIndex);
+      continue;
+    }
+
+    child.column = (int)mColumns.size();
+    child.firstColumn = (uint32_t)mColumns.size();
+    child.endColumn = child.firstColumn + 1;
+    mColumnIndices.insert(std::pair<std::string, uint32_t>(path, (uint32_t)mColumns.size()));
+    mColumns.push_back(column);
+    mNodes[nodeIndex].children.push_back((uint32_t)mNodes.size());
+    mNodes.push_back(child);
+  }
+  mNodes[nodeIndex].endColumn = (uint32_t)mColumns.size();
+  return true;
+}
+
+bool ColumnLayoutImpl::getShallowSize(const std::string & dataType, uint32_t & size)
+{
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  if(client == NULL)
+    return false;
+  try
+  {
+    if(!FabricCore::GetRegisteredTypeIsShallow(*client, dataType.c_str()))
+      return false;
+    size = (uint32_t)FabricCore::GetRegisteredTypeSize(*client, dataType.c_str());
+  }
+  catch(FabricCore::Exception e)
+  {
+    return false;
+  }
+  return size > 0;
+}
+
+bool ColumnLayoutImpl::isRequested(const Node & node, const Transfer & transfer) const
+{
+  for(uint32_t i=node.firstColumn;i<node.endColumn;i++)
+  {
+    if((*transfer.buffers)[i] != NULL)
+      return true;
+  }
+  return false;
+}
+
+bool ColumnLayoutImpl::validate(uint32_t count, const std::vector<Buffer*> & buffers, bool writing, std::string * errorOut) const
+{
+  if(buffers.size() != mColumns.size())
+    return LoggingImpl::reportError("The number of column buffers does not match the column count.", errorOut);
+
+  for(size_t i=0;i<mColumns.size();i++)
+  {
+    const Buffer * buffer = buffers[i];
+    if(buffer == NULL)
+      continue;
+    const Column & column = mColumns[i];
+
+    if(column.type == ColumnType_Shallow)
+    {
+      if(buffer->data == NULL && count > 0)
+        return LoggingImpl::reportError("No valid buffer provided for column '"+column.path+"'.", errorOut);
+      if((uint64_t)count * column.elementSize != buffer->dataSize)
+        return LoggingImpl::reportError("The buffer size of column '"+column.path+"' does not match the element count.", errorOut);
+      continue;
+    }
+
+    if(buffer->offsets == NULL)
+      return LoggingImpl::reportError("No valid offsets provided for column '"+column.path+"'.", errorOut);
+    if(buffer->offsetsCount != (uint64_t)count + 1)
+      return LoggingImpl::reportError("The offsets count of column '"+column.path+"' does not match the element count.", errorOut);
+    if(!writing)
+      continue;
+
+    if(buffer->offsets[0] != 0)
+      return LoggingImpl::reportError("The offsets of column '"+column.path+"' have to start at 0.", errorOut);
+    for(uint32_t j=0;j<count;j++)
+    {
+      if(buffer->offsets[j+1] < buffer->offsets[j])
+        return LoggingImpl::reportError("The offsets of column '"+column.path+"' are not ascending.", errorOut);
+    }
+    if((uint64_t)buffer->offsets[count] * column.elementSize != buffer->dataSize)
+      return LoggingImpl::reportError("The data size of column '"+column.path+"' does not match its offsets.", errorOut);
+    if(buffer->data == NULL && buffer->dataSize > 0)
+      return LoggingImpl::reportError("No valid buffer provided for column '"+column.path+"'.", errorOut);
+  }
+  return true;
+}
+
+bool ColumnLayoutImpl::beginTransfer(uint32_t count, Transfer & transfer)
+{
+  std::vector<Buffer*> & buffers = *transfer.buffers;
+  if(!validate(count, buffers, transfer.writing, transfer.errorOut))
+    return false;
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  transfer.staging.resize(mColumns.size());
+  transfer.cursors.resize(mColumns.size(), 0);
+
+  for(size_t i=0;i<mColumns.size();i++)
+  {
+    Buffer * buffer = buffers[i];
+    if(buffer == NULL)
+      continue;
+    const Column & column = mColumns[i];
+
+    if(column.type == ColumnType_Shallow)
+    {
+      // shallow members are moved through a KL array, so that the host
+      // buffer can be copied in a single step
+      FabricCore::RTVal staging = FabricCore::RTVal::ConstructVariableArray(*client, column.dataType.c_str());
+      staging.setArraySize(count);
+      if(transfer.writing && count > 0)
+        memcpy(staging.callMethod("Data", "data", 0, 0).getData(), buffer->data, buffer->dataSize);
+      transfer.staging[i] = staging;
+    }
+    else if(!transfer.writing)
+      buffer->offsets[0] = 0;
+  }
+  return true;
+}
+
+bool ColumnLayoutImpl::transferNode(uint32_t nodeIndex, FabricCore::RTVal & value, Transfer & transfer)
+{
+  const Node & node = mNodes[nodeIndex];
+
+  // members of null objects are read as defaults
+  bool isNull = !value.isValid() || (node.isObject && value.isNullObject());
+  if(isNull && transfer.writing)
+    return LoggingImpl::reportError("Cannot write columns of a null object.", transfer.errorOut);
+
+  for(size_t i=0;i<node.children.size();i++)
+  {
+    const Node & child = mNodes[node.children[i]];
+    if(!isRequested(child, transfer))
+      continue;
+
+    if(child.column >= 0)
+    {
+      if(transfer.writing)
+      {
+        if(!writeLeaf(child, value, transfer))
+          return false;
+      }
+      else if(!readLeaf(child, isNull ? NULL : &value, transfer))
+        return false;
+      continue;
+    }
+
+    FabricCore::RTVal childValue;
+    if(!isNull)
+      childValue = value.maybeGetMemberRef(child.name.c_str());
+    if(transfer.writing && child.isObject && childValue.isNullObject())
+    {
+      childValue = FabricCore::RTVal::Create(*DGGraphImpl::getClient(), child.dataType.c_str(), 0, 0);
+      value.setMember(child.name.c_str(), childValue);
+    }
+    if(!transferNode(node.children[i], childValue, transfer))
+      return false;
+  }
+  return true;
+}
+
+bool ColumnLayoutImpl::readLeaf(const Node & leaf, FabricCore::RTVal * parent, Transfer & transfer)
+{
+  const Column & column = mColumns[leaf.column];
+  if(column.type == ColumnType_Shallow)
+  {
+    // elements of null objects keep the default of the staging array
+    if(parent)
+      transfer.staging[leaf.column].setArrayElement(transfer.element, parent->maybeGetMember(leaf.name.c_str()));
+    return true;
+  }
+
+  Buffer * buffer = (*transfer.buffers)[leaf.column];
+  uint32_t count = 0;
+  const void * source = NULL;
+  FabricCore::RTVal member;
+  if(parent)
+  {
+    member = parent->maybeGetMemberRef(leaf.name.c_str());
+    if(column.type == ColumnType_String)
+    {
+      count = member.getStringLength();
+      if(count > 0 && buffer->data != NULL)
+        source = member.getStringCString();
+    }
+    else
+    {
+      count = member.getArraySize();
+      if(count > 0 && buffer->data != NULL)
+        source = member.callMethod("Data", "data", 0, 0).getData();
+    }
+  }
+
+  uint32_t & cursor = transfer.cursors[leaf.column];
+  uint64_t end = (uint64_t)cursor + count;
+  if(end > UINT_MAX / column.elementSize)
+    return LoggingImpl::reportError("The data of column '"+column.path+"' exceeds the maximum buffer size.", transfer.errorOut);
+  if(buffer->data != NULL)
+  {
+    if(end * column.elementSize > buffer->dataSize)
+      return LoggingImpl::reportError("The data size of column '"+column.path+"' does not match its offsets.", transfer.errorOut);
+    if(count > 0)
+      memcpy((char*)buffer->data + (size_t)cursor * column.elementSize, source, (size_t)count * column.elementSize);
+  }
+  cursor = (uint32_t)end;
+  buffer->offsets[transfer.element + 1] = cursor;
+  return true;
+}
+
+bool ColumnLayoutImpl::writeLeaf(const Node & leaf, FabricCore::RTVal & parent, Transfer & transfer)
+{
+  const Column & column = mColumns[leaf.column];
+  if(column.type == ColumnType_Shallow)
+  {
+    parent.setMember(leaf.name.c_str(), transfer.staging[leaf.column].getArrayElement(transfer.element));
+    return true;
+  }
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  Buffer * buffer = (*transfer.buffers)[leaf.column];
+  uint32_t begin = buffer->offsets[transfer.element];
+  uint32_t count = buffer->offsets[transfer.element + 1] - begin;
+  const char * source = (const char*)buffer->data + (size_t)begin * column.elementSize;
+
+  if(column.type == ColumnType_String)
+  {
+    parent.setMember(leaf.name.c_str(), FabricCore::RTVal::ConstructString(*client, count > 0 ? source : "", count));
+    return true;
+  }
+
+  FabricCore::RTVal member = FabricCore::RTVal::ConstructVariableArray(*client, column.dataType.c_str());
+  if(count > 0)
+  {
+    member.setArraySize(count);
+    memcpy(member.callMethod("Data", "data", 0, 0).getData(), source, (size_t)count * column.elementSize);
+  }
+  parent.setMember(leaf.name.c_str(), member);
+  return true;
+}
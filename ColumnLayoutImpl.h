@@ -0,0 +1,129 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_COLUMNLAYOUTIMPL_H__
+#define __FabricSpliceImpl_COLUMNLAYOUTIMPL_H__
+
+#include "LoggingImpl.h"
+#include "TypeDefs.h"
+#include <FabricCore.h>
+
+#include <boost/thread/mutex.hpp>
+
+namespace FabricSpliceImpl
+{
+  /// flattens a (possibly non shallow) struct or object type into a set of
+  /// columns, one per shallow member plus one per String or variable array
+  /// member. nested structs and objects are flattened recursively, their
+  /// column paths are joined with a dot (like "xfo.tr" or "info.name").
+  class ColumnLayoutImpl
+  {
+  public:
+
+    enum ColumnType
+    {
+      ColumnType_Shallow,
+      ColumnType_String,
+      ColumnType_Array
+    };
+
+    struct Column
+    {
+      std::string path;
+      std::string dataType;
+      ColumnType type;
+      uint32_t elementSize;
+    };
+
+    /// the host buffer bound to a column for a single transfer.
+    /// variable columns (String and Array) use count + 1 offsets into
+    /// data, counted in column elements (bytes for Strings).
+    struct Buffer
+    {
+      void * data;
+      uint32_t dataSize;
+      uint32_t * offsets;
+      uint32_t offsetsCount;
+    };
+
+    /// returns the layout for a given data type, or an empty pointer if the
+    /// type can't be flattened. layouts are cached per data type.
+    static ColumnLayoutImplPtr getLayout(const std::string & dataType, std::string * errorOut = NULL);
+
+    /// clears the layout cache, f.e. after KL code has been reparsed
+    static void clearCache();
+
+    /// returns the data type this layout describes
+    char const * getDataType() const { return mDataType.c_str(); }
+
+    /// returns the number of columns
+    uint32_t getColumnCount() const { return (uint32_t)mColumns.size(); }
+
+    /// returns a column by index
+    const Column & getColumn(uint32_t index) const { return mColumns[index]; }
+
+    /// returns the index of the column with the given path, or -1
+    int getColumnIndex(const std::string & path) const;
+
+    /// returns the columns as an array of dicts with the keys
+    /// 'path', 'dataType', 'elementSize' and 'variable'
+    FabricCore::Variant getSchema() const;
+
+    /// reads the columns of all elements into the buffers. buffers holds one
+    /// entry per column, NULL for the columns which are not read. variable
+    /// columns without data only receive their offsets.
+    bool read(std::vector<FabricCore::RTVal> & elements, std::vector<Buffer*> & buffers, std::string * errorOut = NULL);
+
+    /// writes the buffers into the columns of all elements, columns
+    /// without a buffer keep their values. null objects are constructed.
+    bool write(std::vector<FabricCore::RTVal> & elements, std::vector<Buffer*> & buffers, std::string * errorOut = NULL);
+
+    /// checks the buffers for a read or write of count elements without touching
+    /// any element, so that callers can validate before resizing the member.
+    bool validate(uint32_t count, const std::vector<Buffer*> & buffers, bool writing, std::string * errorOut = NULL) const;
+
+  private:
+
+    ColumnLayoutImpl(const std::string & dataType);
+
+    // a struct or object member, leaves refer to a column
+    struct Node
+    {
+      std::string name;
+      std::string dataType;
+      bool isObject;
+      int column;
+      uint32_t firstColumn;
+      uint32_t endColumn;
+      std::vector<uint32_t> children;
+    };
+
+    // the state of a single read or write
+    struct Transfer
+    {
+      std::vector<Buffer*> * buffers;
+      std::vector<FabricCore::RTVal> staging;
+      std::vector<uint32_t> cursors;
+      uint32_t element;
+      bool writing;
+      std::string * errorOut;
+    };
+
+    bool appendMembers(uint32_t nodeIndex, const std::string & prefix, stringVector & typeStack, int depth, std::string * errorOut);
+    static bool getShallowSize(const std::string & dataType, uint32_t & size);
+    bool isRequested(const Node & node, const Transfer & transfer) const;
+    bool beginTransfer(uint32_t count, Transfer & transfer);
+    bool transferNode(uint32_t nodeIndex, FabricCore::RTVal & value, Transfer & transfer);
+    bool readLeaf(const Node & leaf, FabricCore::RTVal * parent, Transfer & transfer);
+    bool writeLeaf(const Node & leaf, FabricCore::RTVal & parent, Transfer & transfer);
+
+    std::string mDataType;
+    std::vector<Node> mNodes;
+    std::vector<Column> mColumns;
+    std::map<std::string, uint32_t> mColumnIndices;
+
+    static std::map<std::string, ColumnLayoutImplPtr> sLayouts;
+    static boost::mutex sLayoutsMutex;
+  };
+};
+
+#endif
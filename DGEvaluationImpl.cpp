@@ -0,0 +1,216 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "DGEvaluationImpl.h"
+#include "DGGraphImpl.h"
+#include "ThreadPoolImpl.h"
+
+#include <deque>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+using namespace FabricSpliceImpl;
+
+// the state of all evaluations and the queue are guarded by sMutex
+static boost::mutex sMutex;
+static boost::condition_variable sQueueCondition;
+static boost::condition_variable sDoneCondition;
+static std::deque<DGEvaluationImplPtr> sQueue;
+static DGEvaluationImplPtr sRunning;
+static boost::thread * sThread = NULL;
+static bool sStopping = false;
+
+static bool isDoneState(DGEvaluationImpl::State state)
+{
+  return state == DGEvaluationImpl::State_Succeeded ||
+    state == DGEvaluationImpl::State_Failed ||
+    state == DGEvaluationImpl::State_Cancelled;
+}
+
+DGEvaluationImpl::DGEvaluationImpl(const std::string & graphName, bool shared, CompletedFunc func, void * userData)
+{
+  mGraphName = graphName;
+  mShared = shared;
+  mFunc = func;
+  mUserData = userData;
+  mState = State_Pending;
+  mCancelRequested = false;
+  mCompletedLevels = 0;
+}
+
+DGEvaluationImpl::~DGEvaluationImpl()
+{
+}
+
+DGEvaluationImpl::State DGEvaluationImpl::getState() const
+{
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  return mState;
+}
+
+bool DGEvaluationImpl::isDone() const
+{
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  return isDoneState(mState);
+}
+
+std::string DGEvaluationImpl::getError() const
+{
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  return mError;
+}
+
+bool DGEvaluationImpl::wait(std::string * errorOut)
+{
+  State state = join();
+  if(state == State_Failed)
+    return LoggingImpl::reportError("DGGraph '"+mGraphName+"': "+getError(), errorOut);
+  return state == State_Succeeded;
+}
+
+DGEvaluationImpl::State DGEvaluationImpl::join()
+{
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  while(!isDoneState(mState))
+    sDoneCondition.wait(lock);
+  return mState;
+}
+
+void DGEvaluationImpl::cancel()
+{
+  {
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    if(isDoneState(mState))
+      return;
+    mCancelRequested = true;
+    if(mState == State_Running)
+      return;
+
+    // pending evaluations are done right away, the background thread skips them
+    mState = State_Cancelled;
+  }
+  sDoneCondition.notify_all();
+
+  if(mFunc)
+    (*mFunc)(mGraphName.c_str(), (int)State_Cancelled, mUserData);
+}
+
+void DGEvaluationImpl::shutdown()
+{
+  std::deque<DGEvaluationImplPtr> cancelled;
+  boost::thread * thread = NULL;
+  {
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    if(sRunning)
+      sRunning->mCancelRequested = true;
+    cancelled.swap(sQueue);
+    sStopping = true;
+    thread = sThread;
+    sThread = NULL;
+  }
+  sQueueCondition.notify_all();
+
+  for(size_t i=0;i<cancelled.size();i++)
+    cancelled[i]->cancel();
+
+  if(thread)
+  {
+    thread->join();
+    delete(thread);
+  }
+
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  sStopping = false;
+}
+
+void DGEvaluationImpl::submit(DGEvaluationImplPtr evaluation)
+{
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  sQueue.push_back(evaluation);
+  if(sThread == NULL)
+    sThread = new boost::thread(executorLoop);
+  sQueueCondition.notify_all();
+}
+
+void DGEvaluationImpl::executorLoop()
+{
+  for(;;)
+  {
+    DGEvaluationImplPtr evaluation;
+    {
+      boost::unique_lock<boost::mutex> lock(sMutex);
+      while(!sStopping && sQueue.size() == 0)
+        sQueueCondition.wait(lock);
+      if(sStopping)
+        return;
+      evaluation = sQueue.front();
+      sQueue.pop_front();
+
+      // evaluations cancelled while pending are done already
+      if(evaluation->mState != State_Pending)
+        continue;
+      evaluation->mState = State_Running;
+      sRunning = evaluation;
+    }
+
+    evaluation->execute();
+
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    sRunning.reset();
+  }
+}
+
+void DGEvaluationImpl::execute()
+{
+  DGGraphImpl::EvaluateLevelTask task;
+  task.shared = mShared;
+  for(size_t i=0;i<mLevels.size();i++)
+  {
+    {
+      boost::unique_lock<boost::mutex> lock(sMutex);
+      if(mCancelRequested)
+      {
+        lock.unlock();
+        finish(State_Cancelled, "");
+        return;
+      }
+    }
+
+    task.nodes = mLevels[i];
+    task.errors.clear();
+    task.errors.resize(task.nodes.size());
+    if(task.shared)
+      ThreadPoolImpl::run(DGGraphImpl::evaluateLevelTask, &task, (uint32_t)task.nodes.size());
+    else
+    {
+      for(size_t j=0;j<task.nodes.size();j++)
+        DGGraphImpl::evaluateLevelTask(&task, (uint32_t)j);
+    }
+
+    for(size_t j=0;j<task.errors.size();j++)
+    {
+      if(task.errors[j].length() > 0)
+      {
+        finish(State_Failed, task.errors[j]);
+        return;
+      }
+    }
+
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    mCompletedLevels = (uint32_t)i + 1;
+  }
+  finish(State_Succeeded, "");
+}
+
+void DGEvaluationImpl::finish(State state, const std::string & error)
+{
+  {
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    mState = state;
+    mError = error;
+  }
+  sDoneCondition.notify_all();
+
+  if(mFunc)
+    (*mFunc)(mGraphName.c_str(), (int)state, mUserData);
+}
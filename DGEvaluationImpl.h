@@ -0,0 +1,95 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_DGEVALUATIONIMPL_H__
+#define __FabricSpliceImpl_DGEVALUATIONIMPL_H__
+
+#include "LoggingImpl.h"
+#include "TypeDefs.h"
+#include <FabricCore.h>
+
+namespace FabricSpliceImpl
+{
+  /// the handle of an asynchronous evaluation started with DGGraphImpl::evaluateAsync.
+  /// evaluations are executed in order on a single background thread. for graphs
+  /// evaluating shared the DGNodes of each level are spread across the ThreadPoolImpl.
+  class DGEvaluationImpl
+  {
+    friend class DGGraphImpl;
+
+  public:
+
+    enum State
+    {
+      State_Pending = 0,
+      State_Running = 1,
+      State_Succeeded = 2,
+      State_Failed = 3,
+      State_Cancelled = 4
+    };
+
+    /// called once the evaluation is done. this is called on the background thread, on
+    /// the cancelling thread for evaluations cancelled before they started, or right
+    /// away on the calling thread if there was nothing to evaluate.
+    /// the callback must not access the graph, it is meant to notify the host's UI thread.
+    typedef void (*CompletedFunc)(const char * graphName, int state, void * userData);
+
+    ~DGEvaluationImpl();
+
+    /// returns the name of the evaluated graph
+    char const * getGraphName() const { return mGraphName.c_str(); }
+
+    /// returns the current state
+    State getState() const;
+
+    /// returns true if the evaluation succeeded, failed or has been cancelled
+    bool isDone() const;
+
+    /// returns the error of a failed evaluation
+    std::string getError() const;
+
+    /// blocks until the evaluation is done, returns true if it succeeded
+    bool wait(std::string * errorOut = NULL);
+
+    /// cancels the evaluation without waiting for it. a pending evaluation
+    /// doesn't start, a running one stops after the current level.
+    void cancel();
+
+    /// cancels all evaluations and stops the background thread
+    static void shutdown();
+
+  private:
+
+    DGEvaluationImpl(const std::string & graphName, bool shared, CompletedFunc func, void * userData);
+
+    // queues the evaluation on the background thread
+    static void submit(DGEvaluationImplPtr evaluation);
+
+    // blocks until the evaluation is done and returns its final state
+    State join();
+
+    // evaluates all levels, called on the background thread
+    void execute();
+
+    // sets the final state and calls the callback
+    void finish(State state, const std::string & error);
+
+    static void executorLoop();
+
+    std::string mGraphName;
+    bool mShared;
+    CompletedFunc mFunc;
+    void * mUserData;
+
+    // DGNodes on the same level don't depend on each other
+    std::vector< std::vector<FabricCore::DGNode> > mLevels;
+    std::vector<stringVector> mLevelNames;
+
+    // guarded by the mutex in DGEvaluationImpl.cpp
+    State mState;
+    bool mCancelRequested;
+    uint32_t mCompletedLevels;
+    std::string mError;
+  };
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "DGGraphImpl.h"
 #include "SceneManagementImpl.h"
 #include "KLParserImpl.h"
+#include "ThreadPoolImpl.h"
 
 #include <FTL/FS.h>
 #include <FabricServices/Persistence/RTValToJSONEncoder.hpp>
@@ -10,8 +11,10 @@
 
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <boost/version.hpp>
 #include <boost/algorithm/string.hpp>
@@ -19,13 +22,16 @@
 
 using namespace FabricSpliceImpl;
 
-bool DGGraphImpl::sDGCheckRequired = false;
+uint32_t DGGraphImpl::sDGCheckStamp = 0;
+uint32_t DGGraphImpl::sOperatorCheckStamp = 0;
 unsigned int DGGraphImpl::sInstanceCount = 0;
 FabricCore::Client * DGGraphImpl::sClient = NULL;
 FabricCore::RTVal DGGraphImpl::sDrawingScope;
 bool DGGraphImpl::sClientOwnedByGraph = false;
 stringMap DGGraphImpl::sClientRTs;
 std::vector<DGGraphImpl*> DGGraphImpl::sAllDGGraphs;
+std::vector<DGGraphImpl::Slot> DGGraphImpl::sSlots;
+std::vector<uint32_t> DGGraphImpl::sFreeSlots;
 DGGraphImpl::DGOperatorMap DGGraphImpl::sDGOperators;
 DGGraphImpl::DGOperatorSuffixMap DGGraphImpl::sDGOperatorSuffix;
 FabricServices::Persistence::RTValToJSONEncoder sRTValEncoder;
@@ -213,6 +219,12 @@ DGGraphImpl::DGGraphImpl(
   mUsesEvalContext = false;
   mUserPointer = NULL;
   mIsReferenced = false;
+  mDGCheckRequired = true;
+  mDGCheckStamp = sDGCheckStamp;
+  mOperatorCheckStamp = sOperatorCheckStamp;
+#ifndef NDEBUG
+  mPortCalls = 0;
+#endif
 
   static bool haveDefaultEvaluateShared = false;
   static bool defaultEvaluateShared;
@@ -244,6 +256,22 @@ DGGraphImpl::DGGraphImpl(
   // construct this graph's evaluation context
   mEvalContext = FabricCore::RTVal::Create(*sClient, "EvalContext", 0, 0);
 
+  // register the graph last, so that a failed construction doesn't leave a slot behind.
+  // slots are reused, their generation tells the graphs apart
+  if(sFreeSlots.size() > 0)
+  {
+    mSlot = sFreeSlots.back();
+    sFreeSlots.pop_back();
+  }
+  else
+  {
+    mSlot = (uint32_t)sSlots.size();
+    Slot slot;
+    slot.generation = 0;
+    sSlots.push_back(slot);
+  }
+  sSlots[mSlot].graph = this;
+
   LoggingImpl::log("DGGraph '"+getName()+"' created.");
 }
 
@@ -254,6 +282,16 @@ DGGraphImplPtr DGGraphImpl::construct(const std::string & name, bool guarded, Fa
 
 DGGraphImpl::~DGGraphImpl()
 {
+#ifndef NDEBUG
+  // DGPort calls don't keep the graph alive, destroying it during one is a host error
+  assert(mPortCalls == 0);
+#endif
+
+  // invalidate the registry slot first, the DGPorts treat the graph as destroyed from now on
+  sSlots[mSlot].graph = NULL;
+  sSlots[mSlot].generation++;
+  sFreeSlots.push_back(mSlot);
+
   clear();
   LoggingImpl::log("DGGraph '"+getName()+"' destroyed.");
 
@@ -278,12 +316,11 @@ DGGraphImpl::~DGGraphImpl()
 
   if(sClientOwnedByGraph)
     destroyClient();
-
-  requireDGCheck();
 }
 
 void DGGraphImpl::clear(std::string * errorOut)
 {
+  cancelEvaluation();
   mIsClearing = true;
 
   mLoadedExtensions.clear();
@@ -314,7 +351,7 @@ void DGGraphImpl::clear(std::string * errorOut)
   mDGNodes.clear();
   mIsClearing = false;
   mDGNodeDefaultName = "DGNode";
-  requireDGCheck();
+  requireGraphCheck();
   requireEvaluate();
 }
 
@@ -424,6 +461,9 @@ bool DGGraphImpl::loadExtension(const std::string & extName, std::string * error
 
   sClientRTs.insert(stringPair(name, name));
 
+  // newly registered types can affect the operators of any graph
+  requireDGCheck();
+
   // if we have loaded this type, let's find the corresponding 
   // code files and parse them
   stringVector paths = sExtFolders;
@@ -580,20 +620,14 @@ bool DGGraphImpl::constructDGNode(const std::string & name, std::string * errorO
   if(!isValidName(name, "DGNode"))
     return false;
 
+  cancelEvaluation();
+
   std::string dgNodeName = name;
   if(dgNodeName.length() == 0)
     dgNodeName = mDGNodeDefaultName;
   else if(mDGNodes.size() == 0)
     mDGNodeDefaultName = dgNodeName;
 
-  // todo: this disabled all of the subgraph
-  // functionality - this might have to go away soon
-  if(dgNodeName != mDGNodeDefaultName)
-  {
-    std::string message = "Subgraphs are disabled in this release of Splice. \nThe next iteration of Splice will be based on the Fabric Dataflow Graph, \nwhich will provide Subgraph functionality.\nPlease contact Fabric Engine for more information.";
-    return LoggingImpl::reportError(message, errorOut);
-  }
-  
   DGNodeIt it = mDGNodes.find(dgNodeName);
   if(it != mDGNodes.end())
   {
@@ -606,6 +640,7 @@ bool DGGraphImpl::constructDGNode(const std::string & name, std::string * errorO
   {
     DGNodeData data;
     data.node = FabricCore::DGNode(*sClient, fullDGNodeName.c_str());
+    data.dirty = true;
     mDGNodes.insert(DGNodePair(dgNodeName, data));
 
     data.node.addMember_Variant("context", "EvalContext", FabricCore::Variant());
@@ -616,7 +651,7 @@ bool DGGraphImpl::constructDGNode(const std::string & name, std::string * errorO
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  requireDGCheck();
+  requireGraphCheck();
   requireEvaluate();
 
   LoggingImpl::log("DGGraph '"+getName()+"' constructed new DGNode '"+dgNodeName+"'.");
@@ -634,6 +669,8 @@ bool DGGraphImpl::hasDGNode(const std::string & name) const
 
 bool DGGraphImpl::removeDGNode(const std::string & name, std::string * errorOut)
 {
+  cancelEvaluation();
+
   std::string dgNodeName = name;
   if(dgNodeName.length() == 0)
     dgNodeName = mDGNodeDefaultName;
@@ -657,7 +694,17 @@ bool DGGraphImpl::removeDGNode(const std::string & name, std::string * errorOut)
   FabricCore::DGNode dgNode = it->second.node;
   mDGNodes.erase(it);
   dgNode.destroy();
-  requireDGCheck();
+
+  // drop the node from the dirty propagation of the remaining ones
+  for(DGNodeIt nodeIt = mDGNodes.begin(); nodeIt != mDGNodes.end(); nodeIt++)
+  {
+    stringVector & dependencies = nodeIt->second.dependencies;
+    dependencies.erase(std::remove(dependencies.begin(), dependencies.end(), dgNodeName), dependencies.end());
+    stringVector & dependents = nodeIt->second.dependents;
+    dependents.erase(std::remove(dependents.begin(), dependents.end(), dgNodeName), dependents.end());
+  }
+
+  requireGraphCheck();
   requireEvaluate();
   return true;
 }
@@ -702,57 +749,496 @@ bool DGGraphImpl::evaluate(
   std::string * errorOut
   )
 {
+  // the asynchronous evaluation in flight is likely to cover the DGNode
+  if(mEvaluation)
+    collectEvaluation(false);
+
   if(!mRequiresEval || mIsPersisting)
     return true;
 
   if(!dgNode.isValid())
     return LoggingImpl::reportError("No valid DGNode provided.", errorOut);
 
-  if(!checkErrors(errorOut))
+  // nodes which are clean don't depend on any dirty node either
+  DGNodeIt it = findDGNode(dgNode);
+  if(it != mDGNodes.end() && !it->second.dirty)
+    return true;
+
+  if(!checkGraphErrors(errorOut))
   {
     SceneManagementImpl::setErrorStatus(true);
     return false;
   }
   SceneManagementImpl::setErrorStatus(false);
 
+  if(!syncExternalArrayData(errorOut))
+    return false;
+
+  return evaluateDGNodes(std::vector<FabricCore::DGNode>(1, dgNode), errorOut);
+}
+
+bool DGGraphImpl::evaluate(
+  const std::string & name,
+  std::string * errorOut
+  )
+{
+  // without a name all DGNodes of a subgraph are evaluated
+  if(name.length() == 0 && mDGNodes.size() > 1)
+  {
+    std::vector<FabricCore::DGNode> dgNodes;
+    for(DGNodeIt it = mDGNodes.begin(); it != mDGNodes.end(); it++)
+      dgNodes.push_back(it->second.node);
+    return evaluate(dgNodes, errorOut);
+  }
+
+  FabricCore::DGNode dgNode = getDGNode(name);
+  if(!dgNode.isValid())
+    return LoggingImpl::reportError("DGNode '"+name+"' does not exist.", errorOut);
+  return evaluate(dgNode, errorOut);
+}
+
+bool DGGraphImpl::evaluate(
+  const std::vector<FabricCore::DGNode> & dgNodes,
+  std::string * errorOut
+  )
+{
+  if(mEvaluation)
+    collectEvaluation(false);
+
+  if(!mRequiresEval || mIsPersisting)
+    return true;
+
+  std::vector<DGNodeIt> dirtyNodes;
+  for(size_t i=0;i<dgNodes.size();i++)
+  {
+    if(!dgNodes[i].isValid())
+      return LoggingImpl::reportError("No valid DGNode provided.", errorOut);
+    DGNodeIt it = findDGNode(dgNodes[i]);
+    if(it == mDGNodes.end() || it->second.dirty)
+      dirtyNodes.push_back(it);
+  }
+  if(dirtyNodes.size() == 0)
+    return true;
+
+  if(!checkGraphErrors(errorOut))
+  {
+    SceneManagementImpl::setErrorStatus(true);
+    return false;
+  }
+  SceneManagementImpl::setErrorStatus(false);
+
+  if(!syncExternalArrayData(errorOut))
+    return false;
+
+  return evaluateDGNodes(dgNodes, errorOut);
+}
+
+bool DGGraphImpl::evaluateDGNodes(
+  const std::vector<FabricCore::DGNode> & dgNodes,
+  std::string * errorOut
+  )
+{
+  // DGNodes on the same level have no dependency path between them, so each level
+  // is evaluated concurrently. exclusive evaluations would only queue up on the
+  // lock, so those evaluate the level one DGNode after the other.
+  std::vector< std::vector<DGNodeIt> > schedule;
+  std::vector<FabricCore::DGNode> unknownNodes;
+  getDGNodeSchedule(dgNodes, schedule, unknownNodes);
+
+  EvaluateLevelTask task;
+  task.shared = mEvaluateShared;
+  for(size_t i=0;i<schedule.size();i++)
+  {
+    task.nodes.resize(schedule[i].size());
+    task.errors.clear();
+    task.errors.resize(schedule[i].size());
+    for(size_t j=0;j<schedule[i].size();j++)
+      task.nodes[j] = schedule[i][j]->second.node;
+
+    if(task.shared)
+      ThreadPoolImpl::run(evaluateLevelTask, &task, (uint32_t)task.nodes.size());
+    else
+    {
+      for(size_t j=0;j<task.nodes.size();j++)
+        evaluateLevelTask(&task, (uint32_t)j);
+    }
+
+    bool failed = false;
+    for(size_t j=0;j<schedule[i].size();j++)
+    {
+      if(task.errors[j].length() > 0)
+      {
+        LoggingImpl::reportError(task.errors[j], errorOut);
+        failed = true;
+      }
+      else
+        schedule[i][j]->second.dirty = false;
+    }
+    if(failed)
+      return false;
+  }
+
+  // DGNodes which don't belong to this graph are evaluated as they are
   try
   {
-    dgNode.evaluate_lockType(
-      mEvaluateShared?
-        FabricCore::LockType_Shared:
-        FabricCore::LockType_Exclusive
-        );
+    for(size_t i=0;i<unknownNodes.size();i++)
+    {
+      unknownNodes[i].evaluate_lockType(
+        mEvaluateShared?
+          FabricCore::LockType_Shared:
+          FabricCore::LockType_Exclusive
+          );
+    }
   }
   catch(FabricCore::Exception e)
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  mRequiresEval = false;
+  if(unknownNodes.size() > 0)
+    mRequiresEval = false;
+  else
+    updateRequiresEval();
   return true;
 }
 
-bool DGGraphImpl::evaluate(
-  const std::string & name,
+void DGGraphImpl::getDGNodeSchedule(
+  const std::vector<FabricCore::DGNode> & dgNodes,
+  std::vector< std::vector<DGNodeIt> > & schedule,
+  std::vector<FabricCore::DGNode> & unknownNodes
+  )
+{
+  // every dirty DGNode the given ones depend on is assigned the
+  // length of its longest path of dirty dependencies
+  std::map<std::string, uint32_t> levels;
+  for(size_t i=0;i<dgNodes.size();i++)
+  {
+    DGNodeIt it = findDGNode(dgNodes[i]);
+    if(it == mDGNodes.end())
+      unknownNodes.push_back(dgNodes[i]);
+    else if(it->second.dirty)
+      getDGNodeLevel(it, levels);
+  }
+
+  for(std::map<std::string, uint32_t>::iterator it = levels.begin(); it != levels.end(); it++)
+  {
+    if(schedule.size() <= it->second)
+      schedule.resize(it->second + 1);
+    schedule[it->second].push_back(mDGNodes.find(it->first));
+  }
+}
+
+uint32_t DGGraphImpl::getDGNodeLevel(DGNodeIt it, std::map<std::string, uint32_t> & levels)
+{
+  std::map<std::string, uint32_t>::iterator levelIt = levels.find(it->first);
+  if(levelIt != levels.end())
+    return levelIt->second;
+
+  uint32_t level = 0;
+  stringVector & dependencies = it->second.dependencies;
+  for(size_t i=0;i<dependencies.size();i++)
+  {
+    DGNodeIt dependencyIt = mDGNodes.find(dependencies[i]);
+    if(dependencyIt == mDGNodes.end() || !dependencyIt->second.dirty)
+      continue;
+    uint32_t dependencyLevel = getDGNodeLevel(dependencyIt, levels) + 1;
+    if(dependencyLevel > level)
+      level = dependencyLevel;
+  }
+  levels.insert(std::pair<std::string, uint32_t>(it->first, level));
+  return level;
+}
+
+void DGGraphImpl::evaluateLevelTask(void * userData, uint32_t index)
+{
+  EvaluateLevelTask * task = (EvaluateLevelTask *)userData;
+  try
+  {
+    task->nodes[index].evaluate_lockType(
+      task->shared?
+        FabricCore::LockType_Shared:
+        FabricCore::LockType_Exclusive
+        );
+  }
+  catch(FabricCore::Exception e)
+  {
+    task->errors[index] = e.getDesc_cstr();
+  }
+}
+
+bool DGGraphImpl::evaluateAll(
+  const std::vector<DGGraphImplPtr> & graphs,
+  bool parallel,
+  bool * results,
   std::string * errorOut
   )
 {
-  // todo: for subgraphs here we need to probably evaluate the leaf 
-  // output nodes
-  FabricCore::DGNode dgNode = getDGNode(name);
-  if(!dgNode.isValid())
-    return LoggingImpl::reportError("DGNode '"+name+"' does not exist.", errorOut);
-  return evaluate(dgNode, errorOut);
+  if(results)
+  {
+    for(size_t i=0;i<graphs.size();i++)
+      results[i] = false;
+  }
+
+  // everything touching the DGPorts happens up front on the calling thread,
+  // the tasks only evaluate the DGNodes. each graph is checked for errors
+  // on its own, a graph with errors doesn't keep the others from evaluating.
+  bool result = true;
+  bool hasErrors = false;
+  std::vector<DGGraphImpl *> dirtyGraphs;
+  std::vector<size_t> indices;
+  std::map<DGGraphImpl *, size_t> firstIndices;
+  std::vector< std::pair<size_t, size_t> > duplicates;
+  size_t sharedCount = 0;
+  for(size_t i=0;i<graphs.size();i++)
+  {
+    DGGraphImpl * graph = graphs[i].get();
+    if(!graph)
+    {
+      result = LoggingImpl::reportError("No valid DGGraph provided.", errorOut);
+      continue;
+    }
+
+    // a graph listed twice is only evaluated once, two tasks
+    // must never evaluate the same DGNodes concurrently
+    std::map<DGGraphImpl *, size_t>::iterator first = firstIndices.find(graph);
+    if(first != firstIndices.end())
+    {
+      duplicates.push_back(std::pair<size_t, size_t>(i, first->second));
+      continue;
+    }
+    firstIndices.insert(std::pair<DGGraphImpl *, size_t>(graph, i));
+
+    if(graph->mEvaluation)
+      graph->collectEvaluation(false);
+    if(!graph->mRequiresEval || graph->mIsPersisting)
+    {
+      if(results)
+        results[i] = true;
+      continue;
+    }
+    if(!graph->checkGraphErrors(errorOut))
+    {
+      hasErrors = true;
+      result = false;
+      continue;
+    }
+    if(!graph->syncExternalArrayData(errorOut))
+    {
+      result = false;
+      continue;
+    }
+    dirtyGraphs.push_back(graph);
+    indices.push_back(i);
+    if(graph->mEvaluateShared)
+      sharedCount++;
+  }
+  SceneManagementImpl::setErrorStatus(hasErrors);
+
+  // shared graphs are spread across the thread pool, each one evaluating its dirty
+  // DGNodes level by level. exclusive graphs would only queue up on the lock, so
+  // those are evaluated on the calling thread, as is a single shared graph, which
+  // spreads its levels across the thread pool instead.
+  bool spread = parallel && sharedCount > 1;
+  EvaluateAllTask task;
+  std::vector<size_t> taskIndices;
+  for(size_t i=0;i<dirtyGraphs.size();i++)
+  {
+    DGGraphImpl * graph = dirtyGraphs[i];
+    std::vector<FabricCore::DGNode> dgNodes;
+    for(DGNodeIt it = graph->mDGNodes.begin(); it != graph->mDGNodes.end(); it++)
+    {
+      if(it->second.dirty)
+        dgNodes.push_back(it->second.node);
+    }
+
+    if(spread && graph->mEvaluateShared)
+    {
+      std::vector<FabricCore::DGNode> unknownNodes;
+      task.graphs.push_back(graph);
+      task.schedules.push_back(std::vector< std::vector<DGNodeIt> >());
+      graph->getDGNodeSchedule(dgNodes, task.schedules.back(), unknownNodes);
+      taskIndices.push_back(indices[i]);
+      continue;
+    }
+
+    std::string error;
+    if(!graph->evaluateDGNodes(dgNodes, &error))
+    {
+      result = LoggingImpl::reportError("DGGraph '"+graph->getName()+"': "+error, errorOut);
+      continue;
+    }
+    if(results)
+      results[indices[i]] = true;
+  }
+
+  if(task.graphs.size() > 0)
+  {
+    task.completedLevels.resize(task.graphs.size(), 0);
+    task.errors.resize(task.graphs.size());
+    ThreadPoolImpl::run(evaluateAllTask, &task, (uint32_t)task.graphs.size());
+
+    // the levels completed before a failure stay clean
+    for(size_t i=0;i<task.graphs.size();i++)
+    {
+      std::vector< std::vector<DGNodeIt> > & schedule = task.schedules[i];
+      for(uint32_t j=0;j<task.completedLevels[i];j++)
+      {
+        for(size_t k=0;k<schedule[j].size();k++)
+          schedule[j][k]->second.dirty = false;
+      }
+      task.graphs[i]->updateRequiresEval();
+
+      if(task.errors[i].length() > 0)
+      {
+        result = LoggingImpl::reportError("DGGraph '"+task.graphs[i]->getName()+"': "+task.errors[i], errorOut);
+        continue;
+      }
+      if(results)
+        results[taskIndices[i]] = true;
+    }
+  }
+
+  if(results)
+  {
+    for(size_t i=0;i<duplicates.size();i++)
+      results[duplicates[i].first] = results[duplicates[i].second];
+  }
+
+  return result;
+}
+
+void DGGraphImpl::evaluateAllTask(void * userData, uint32_t index)
+{
+  EvaluateAllTask * task = (EvaluateAllTask *)userData;
+  std::vector< std::vector<DGNodeIt> > & schedule = task->schedules[index];
+  try
+  {
+    for(size_t i=0;i<schedule.size();i++)
+    {
+      for(size_t j=0;j<schedule[i].size();j++)
+        schedule[i][j]->second.node.evaluate_lockType(FabricCore::LockType_Shared);
+      task->completedLevels[index]++;
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    task->errors[index] = e.getDesc_cstr();
+  }
+}
+
+bool DGGraphImpl::syncExternalArrayData(std::string * errorOut)
+{
+  for(DGPortIt it = mDGPorts.begin(); it != mDGPorts.end(); it++)
+  {
+    if(!it->second->hasExternalArrayData())
+      continue;
+    if(!it->second->syncExternalArrayData(errorOut))
+      return false;
+  }
+  return true;
 }
 
 bool DGGraphImpl::clearEvaluate(std::string * errorOut)
 {
+  cancelEvaluation();
   if(!mRequiresEval)
     return false;
+  for(DGNodeIt it = mDGNodes.begin(); it != mDGNodes.end(); it++)
+    it->second.dirty = false;
   mRequiresEval = false;
   return true;
 }
 
+DGEvaluationImplPtr DGGraphImpl::evaluateAsync(
+  DGEvaluationImpl::CompletedFunc func,
+  void * userData,
+  std::string * errorOut
+  )
+{
+  // a new evaluation supersedes the one in flight
+  cancelEvaluation();
+
+  DGEvaluationImplPtr evaluation(new DGEvaluationImpl(getName(), mEvaluateShared, func, userData));
+  if(!mRequiresEval || mIsPersisting)
+  {
+    evaluation->finish(DGEvaluationImpl::State_Succeeded, "");
+    return evaluation;
+  }
+
+  if(!checkGraphErrors(errorOut))
+  {
+    SceneManagementImpl::setErrorStatus(true);
+    return DGEvaluationImplPtr();
+  }
+  SceneManagementImpl::setErrorStatus(false);
+
+  // everything touching the DGPorts happens on the calling thread,
+  // the background thread only evaluates the scheduled DGNodes
+  if(!syncExternalArrayData(errorOut))
+    return DGEvaluationImplPtr();
+
+  std::vector<FabricCore::DGNode> dgNodes;
+  for(DGNodeIt it = mDGNodes.begin(); it != mDGNodes.end(); it++)
+    dgNodes.push_back(it->second.node);
+  std::vector< std::vector<DGNodeIt> > schedule;
+  std::vector<FabricCore::DGNode> unknownNodes;
+  getDGNodeSchedule(dgNodes, schedule, unknownNodes);
+
+  evaluation->mLevels.resize(schedule.size());
+  evaluation->mLevelNames.resize(schedule.size());
+  for(size_t i=0;i<schedule.size();i++)
+  {
+    for(size_t j=0;j<schedule[i].size();j++)
+    {
+      evaluation->mLevels[i].push_back(schedule[i][j]->second.node);
+      evaluation->mLevelNames[i].push_back(schedule[i][j]->first);
+    }
+  }
+
+  if(schedule.size() == 0)
+  {
+    updateRequiresEval();
+    evaluation->finish(DGEvaluationImpl::State_Succeeded, "");
+    return evaluation;
+  }
+
+  mEvaluation = evaluation;
+  DGEvaluationImpl::submit(evaluation);
+  return evaluation;
+}
+
+bool DGGraphImpl::waitForEvaluation(std::string * errorOut)
+{
+  if(!mEvaluation)
+    return true;
+  DGEvaluationImplPtr evaluation = mEvaluation;
+  collectEvaluation(false);
+  return evaluation->wait(errorOut);
+}
+
+void DGGraphImpl::collectEvaluation(bool cancel)
+{
+  DGEvaluationImplPtr evaluation = mEvaluation;
+  mEvaluation.reset();
+  if(cancel)
+    evaluation->cancel();
+  evaluation->join();
+
+  // the DGNodes are only changed on this thread, the levels
+  // completed before a cancellation or failure stay clean
+  for(uint32_t i=0;i<evaluation->mCompletedLevels;i++)
+  {
+    const stringVector & names = evaluation->mLevelNames[i];
+    for(size_t j=0;j<names.size();j++)
+    {
+      DGNodeIt it = mDGNodes.find(names[j]);
+      if(it != mDGNodes.end())
+        it->second.dirty = false;
+    }
+  }
+  updateRequiresEval();
+}
+
 bool DGGraphImpl::usesEvalContext()
 {
   return mUsesEvalContext;
@@ -834,7 +1320,7 @@ bool DGGraphImpl::addDGNodeMember(
   }
 
 
-  requireDGCheck();
+  requireGraphCheck();
   requireEvaluate();
   return true;
 }
@@ -931,7 +1417,7 @@ bool DGGraphImpl::removeDGNodeMember(
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  requireDGCheck();
+  requireGraphCheck();
   requireEvaluate();
   return true;
 }
@@ -1108,44 +1594,67 @@ bool DGGraphImpl::hasDGNodeDependency(const std::string & dgNode, const std::str
 
 bool DGGraphImpl::setDGNodeDependency(const std::string & dgNode, const std::string & dependency, std::string * errorOut)
 {
-  if(dgNode == dependency)
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' and the dependency are the same.", errorOut);
+  std::string dgNodeName = dgNode;
+  if(dgNodeName.length() == 0)
+    dgNodeName = mDGNodeDefaultName;
+  std::string dependencyName = dependency;
+  if(dependencyName.length() == 0)
+    dependencyName = mDGNodeDefaultName;
 
-  FabricCore::DGNode nodeA = getDGNode(dgNode);
-  if(!nodeA.isValid())
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' does not exist.", errorOut);
-  FabricCore::DGNode nodeB = getDGNode(dependency);
-  if(!nodeB.isValid())
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' does not exist.", errorOut);
+  if(dgNodeName == dependencyName)
+    return LoggingImpl::reportError("DGNode '"+dgNodeName+"' and the dependency are the same.", errorOut);
+
+  DGNodeIt itA = mDGNodes.find(dgNodeName);
+  if(itA == mDGNodes.end())
+    return LoggingImpl::reportError("DGNode '"+dgNodeName+"' does not exist.", errorOut);
+  DGNodeIt itB = mDGNodes.find(dependencyName);
+  if(itB == mDGNodes.end())
+    return LoggingImpl::reportError("DGNode '"+dependencyName+"' does not exist.", errorOut);
+
+  FabricCore::DGNode nodeA = itA->second.node;
+  FabricCore::DGNode nodeB = itB->second.node;
 
-  if(hasDGNodeDependency(dgNode, dependency))
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' already depends on DGNode '"+dependency+"'.", errorOut);
+  if(hasDGNodeDependency(dgNodeName, dependencyName))
+    return LoggingImpl::reportError("DGNode '"+dgNodeName+"' already depends on DGNode '"+dependencyName+"'.", errorOut);
 
   try
   {
-    nodeA.setDependency(dependency.c_str(), nodeB);
+    nodeA.setDependency(dependencyName.c_str(), nodeB);
   }
   catch(FabricCore::Exception e)
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  LoggingImpl::log("DGGraph '"+getName()+"' constructed new DGNodeDependency '"+dgNode+"-->"+dependency+"'.");
+  itA->second.dependencies.push_back(dependencyName);
+  itB->second.dependents.push_back(dgNodeName);
+  requireEvaluate(dgNodeName);
+
+  LoggingImpl::log("DGGraph '"+getName()+"' constructed new DGNodeDependency '"+dgNodeName+"-->"+dependencyName+"'.");
 
   return true;
 }
 
 bool DGGraphImpl::removeDGNodeDependency(const std::string & dgNode, const std::string & dependency, std::string * errorOut)
 {
-  FabricCore::DGNode nodeA = getDGNode(dgNode);
-  if(!nodeA.isValid())
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' does not exist.", errorOut);
-  FabricCore::DGNode nodeB = getDGNode(dependency);
-  if(!nodeB.isValid())
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' does not exist.", errorOut);
+  std::string dgNodeName = dgNode;
+  if(dgNodeName.length() == 0)
+    dgNodeName = mDGNodeDefaultName;
+  std::string dependencyName = dependency;
+  if(dependencyName.length() == 0)
+    dependencyName = mDGNodeDefaultName;
 
-  if(!hasDGNodeDependency(dgNode, dependency))
-    return LoggingImpl::reportError("DGNode '"+dgNode+"' doesn't depend on DGNode '"+dependency+"'.", errorOut);
+  DGNodeIt itA = mDGNodes.find(dgNodeName);
+  if(itA == mDGNodes.end())
+    return LoggingImpl::reportError("DGNode '"+dgNodeName+"' does not exist.", errorOut);
+  DGNodeIt itB = mDGNodes.find(dependencyName);
+  if(itB == mDGNodes.end())
+    return LoggingImpl::reportError("DGNode '"+dependencyName+"' does not exist.", errorOut);
+
+  FabricCore::DGNode nodeA = itA->second.node;
+
+  if(!hasDGNodeDependency(dgNodeName, dependencyName))
+    return LoggingImpl::reportError("DGNode '"+dgNodeName+"' doesn't depend on DGNode '"+dependencyName+"'.", errorOut);
 
   // remove all operators using this dependency
   FabricCore::DGBindingList bindings = nodeA.getBindingList();
@@ -1161,7 +1670,7 @@ bool DGGraphImpl::removeDGNodeDependency(const std::string & dgNode, const std::
       stringVector parts = StringUtilityImpl::splitString(paramLayout.getArrayElement(j)->getStringData(), '.');
       if(parts.size() < 1)
         continue;
-      if(parts[0] == dependency)
+      if(parts[0] == dependencyName)
         bindingsToRemove.push_back(i);
     }
   }
@@ -1176,14 +1685,20 @@ bool DGGraphImpl::removeDGNodeDependency(const std::string & dgNode, const std::
 
   try
   {
-    nodeA.removeDependency(dependency.c_str());
+    nodeA.removeDependency(dependencyName.c_str());
   }
   catch(FabricCore::Exception e)
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  LoggingImpl::log("DGGraph '"+getName()+"' removed DGNodeDependency '"+dgNode+"-->"+dependency+"'.");
+  stringVector & dependencies = itA->second.dependencies;
+  dependencies.erase(std::remove(dependencies.begin(), dependencies.end(), dependencyName), dependencies.end());
+  stringVector & dependents = itB->second.dependents;
+  dependents.erase(std::remove(dependents.begin(), dependents.end(), dgNodeName), dependents.end());
+  requireEvaluate(dgNodeName);
+
+  LoggingImpl::log("DGGraph '"+getName()+"' removed DGNodeDependency '"+dgNodeName+"-->"+dependencyName+"'.");
 
   return true;
 }
@@ -1238,27 +1753,66 @@ bool DGGraphImpl::checkErrorVariant(const FabricCore::Variant * variant, std::st
 
 bool DGGraphImpl::checkErrors(std::string * errorOut)
 {
-  if(!sDGCheckRequired)
+  bool result = true;
+  for(size_t i=0;i<sAllDGGraphs.size();i++)
+  {
+    if(!sAllDGGraphs[i]->checkGraphErrors(errorOut))
+      result = false;
+  }
+  return result;
+}
+
+bool DGGraphImpl::checkGraphErrors(std::string * errorOut)
+{
+  bool full = mDGCheckRequired || mDGCheckStamp != sDGCheckStamp;
+  if(!full && mOperatorCheckStamp == sOperatorCheckStamp)
     return true;
 
   bool result = true;
 
-  // loop over all operators
-  for(DGOperatorIt opIt = sDGOperators.begin(); opIt != sDGOperators.end(); opIt++)
+  // loop over the bound operators, only operators which changed since
+  // the binding was last checked are looked at unless a full check is required
+  for(size_t i=0;i<mBindings.size();i++)
   {
-    FabricCore::Variant feedback = opIt->second.op.getErrors();
+    DGBindingData & data = mBindings[i];
+    DGOperatorIt opIt = sDGOperators.find(getRealDGOperatorName(data.opName.c_str()));
+    if(opIt == sDGOperators.end())
+      continue;
+    DGOperatorData & opData = opIt->second;
+    if(!full && data.checkedVersion == opData.version)
+      continue;
+
+    // the operator is shared by all graphs using it, its errors are
+    // reported to each of them, so they are tracked per binding
+    FabricCore::Variant feedback = opData.op.getErrors();
     if(!checkErrorVariant(&feedback, errorOut))
       result = false;
-    feedback = opIt->second.op.getDiagnostics();
+    feedback = opData.op.getDiagnostics();
     if(!checkErrorVariant(&feedback, errorOut))
       result = false;
+
+    // the bindings are checked below for a full check
+    if(!full)
+    {
+      DGNodeIt nodeIt = mDGNodes.find(data.dgNode);
+      if(nodeIt != mDGNodes.end())
+      {
+        FabricCore::DGBindingList bindings = nodeIt->second.node.getBindingList();
+        if(data.index < bindings.getCount())
+        {
+          feedback = bindings.getBinding(data.index).getErrors();
+          if(!checkErrorVariant(&feedback, errorOut))
+            result = false;
+        }
+      }
+    }
+    data.checkedVersion = opData.version;
   }
 
   // loop over all nodes and validate their bindings
-  for(size_t i=0;i<sAllDGGraphs.size();i++)
+  if(full)
   {
-    DGNodeMap & dgNodeMap = sAllDGGraphs[i]->mDGNodes;
-    for(DGNodeIt nodeIt = dgNodeMap.begin(); nodeIt != dgNodeMap.end(); nodeIt++)
+    for(DGNodeIt nodeIt = mDGNodes.begin(); nodeIt != mDGNodes.end(); nodeIt++)
     {
       FabricCore::Variant feedback = nodeIt->second.node.getErrors();
       if(!checkErrorVariant(&feedback, errorOut))
@@ -1275,7 +1829,9 @@ bool DGGraphImpl::checkErrors(std::string * errorOut)
     }
   }
 
-  sDGCheckRequired = false;
+  mDGCheckRequired = false;
+  mDGCheckStamp = sDGCheckStamp;
+  mOperatorCheckStamp = sOperatorCheckStamp;
   return result;
 }
 
@@ -1508,6 +2064,7 @@ bool DGGraphImpl::constructKLOperator(
     bindingData.dgNode = dgNodeName;
     bindingData.index = node.getBindingList().getCount();
     bindingData.portName.clear();
+    bindingData.checkedVersion = 0;
     mBindings.push_back(bindingData);
 
     node.appendBinding(binding);
@@ -1521,10 +2078,10 @@ bool DGGraphImpl::constructKLOperator(
 
   FabricCore::Variant portMapClone = FabricCore::Variant::CreateFromJSON(opPortMap.getJSONEncoding().getStringData());
   mDGNodes.find(dgNodeName)->second.opPortMaps.push_back(portMapClone);
+  requireGraphCheck();
   if(klCode.length() > 0)
     return setKLOperatorSourceCode(name, klCode, entry, errorOut);
 
-  requireDGCheck();
   requireEvaluate();
   return true;
 }
@@ -1653,12 +2210,14 @@ bool DGGraphImpl::setKLOperatorEntry(const std::string & name, const std::string
 
   LoggingImpl::log("KL Operator '"+name+"' entry updated.");
 
-  requireDGCheck();
-  return checkErrors(errorOut);
+  requireOperatorCheck(opIt->second);
+  return checkGraphErrors(errorOut);
 }
 
 bool DGGraphImpl::setKLOperatorIndex(const std::string & name, unsigned int index, std::string * errorOut)
 {
+  cancelEvaluation();
+
   std::string opName = getRealDGOperatorName(name.c_str());
   DGOperatorIt opIt = sDGOperators.find(opName);
   if(opIt == sDGOperators.end())
@@ -1667,29 +2226,17 @@ bool DGGraphImpl::setKLOperatorIndex(const std::string & name, unsigned int inde
     return false;
   }
 
-  if(index >= mBindings.size())
-  {
-    LoggingImpl::reportError("New index for Operator '"+name+"' is out of bounds.", errorOut);
-    return false;
-  }
-
-  FabricCore::DGOperator op = opIt->second.op;
-
   DGBindingData * prevBindingData = NULL;
-  DGBindingData * newBindingData = NULL;
 
   for(size_t i=0;i<mBindings.size();i++)
   {
     FabricCore::DGNode node = getDGNode(mBindings[i].dgNode);
     FabricCore::DGBindingList bindings = node.getBindingList();
     FabricCore::DGBinding binding = bindings.getBinding(mBindings[i].index);
-    if(binding.getOperator().getName() == opName && prevBindingData == NULL)
+    if(binding.getOperator().getName() == opName)
     {
       prevBindingData = &mBindings[i];
-    }
-    if(mBindings[i].index == index && newBindingData == NULL)
-    {
-      newBindingData = &mBindings[i];
+      break;
     }
   }
 
@@ -1699,9 +2246,13 @@ bool DGGraphImpl::setKLOperatorIndex(const std::string & name, unsigned int inde
     return false;
   }
 
-  if(newBindingData == NULL)
+  // the index refers to the binding list of the DGNode the operator is bound to
+  std::string dgNodeName = prevBindingData->dgNode;
+  FabricCore::DGNode node = getDGNode(dgNodeName);
+  FabricCore::DGBindingList bindings = node.getBindingList();
+  if(index >= bindings.getCount())
   {
-    LoggingImpl::reportError("Operator '"+name+"'cannot be moved, invalid index.", errorOut);
+    LoggingImpl::reportError("New index for Operator '"+name+"' is out of bounds.", errorOut);
     return false;
   }
 
@@ -1714,8 +2265,6 @@ bool DGGraphImpl::setKLOperatorIndex(const std::string & name, unsigned int inde
     return false;
   }
 
-  FabricCore::DGNode node = getDGNode(prevBindingData->dgNode);
-  FabricCore::DGBindingList bindings = node.getBindingList();
   FabricCore::DGBinding binding = bindings.getBinding(prevIndex);
   bindings.remove(prevIndex);
   if(newIndex > prevIndex + 1)
@@ -1723,29 +2272,33 @@ bool DGGraphImpl::setKLOperatorIndex(const std::string & name, unsigned int inde
   else
     bindings.insert(binding, newIndex);
 
-  std::vector<DGBindingData> newBindings(bindings.getCount());
-  for(size_t i=0;i<newBindings.size();i++)
+  // only the bindings of this DGNode moved, the bindings of the
+  // other DGNodes keep their indices
+  stringVector boundOpNames(bindings.getCount());
+  for(size_t i=0;i<boundOpNames.size();i++)
+    boundOpNames[i] = bindings.getBinding(i).getOperator().getName();
+  for(size_t i=0;i<mBindings.size();i++)
   {
-    FabricCore::DGBinding binding = bindings.getBinding(i);
-    newBindings[i].valid = true;
-    newBindings[i].dgNode = "DGNode";
-    newBindings[i].index = i;
-    newBindings[i].opName = binding.getOperator().getName();
-
-    for(size_t j=0;j<mBindings.size();j++)
+    if(mBindings[i].dgNode != dgNodeName)
+      continue;
+    std::string realOpName = getRealDGOperatorName(mBindings[i].opName.c_str());
+    for(size_t j=0;j<boundOpNames.size();j++)
     {
-      if(mBindings[j].opName == newBindings[i].opName)
+      if(boundOpNames[j] == realOpName)
       {
-        newBindings[i].portName = mBindings[j].portName;
+        mBindings[i].index = j;
+        mBindings[i].checkedVersion = 0;
         break;
       }
     }
   }
 
-  mBindings = newBindings;
+  // the DGNode's operators run in a different order now
+  requireEvaluate(dgNodeName);
 
   LoggingImpl::log("KL Operator '"+name+"' moved.");
-  return checkErrors(errorOut);
+  requireGraphCheck();
+  return checkGraphErrors(errorOut);
 }
 
 char const * DGGraphImpl::getKLOperatorSourceCode(const std::string & name, std::string * errorOut)
@@ -1894,8 +2447,8 @@ bool DGGraphImpl::setKLOperatorSourceCode(
   LoggingImpl::log("KL Operator '"+name+"' sourcecode updated.");
   LoggingImpl::clearError();
 
-  requireDGCheck();
-  return checkErrors(errorOut);
+  requireOperatorCheck(opIt->second);
+  return checkGraphErrors(errorOut);
 }
 
 void DGGraphImpl::loadKLOperatorSourceCode(const std::string & name, const std::string & filePath, std::string * errorOut)
@@ -2244,6 +2797,7 @@ bool DGGraphImpl::validateKLOperator(const std::string & opName, bool logValidat
       free(parameterLayoutChar);
 
       sAllDGGraphs[i]->requireEvaluate();
+      sAllDGGraphs[i]->requireGraphCheck();
       data.valid = true;
 
       LoggingImpl::log(std::string("KLOperator '")+op.getName()+"' on DGNode '"+data.dgNode+"' validated.");
@@ -3159,16 +3713,82 @@ const char * DGGraphImpl::getReferencedFilePath()
 
 bool DGGraphImpl::requireEvaluate()
 {
-  if(mRequiresEval)
-    return false;
+  // changed inputs supersede the evaluation in flight
+  cancelEvaluation();
 
+  bool result = !mRequiresEval;
   for(DGNodeIt nodeIt = mDGNodes.begin(); nodeIt != mDGNodes.end(); nodeIt++)
+  {
+    if(nodeIt->second.dirty)
+      continue;
+    nodeIt->second.dirty = true;
     nodeIt->second.node.setDirty();
+    result = true;
+  }
 
   mRequiresEval = true;
+  return result;
+}
+
+bool DGGraphImpl::requireEvaluate(const std::string & dgNode)
+{
+  cancelEvaluation();
+
+  std::string dgNodeName = dgNode;
+  if(dgNodeName.length() == 0)
+    dgNodeName = mDGNodeDefaultName;
+  DGNodeIt it = mDGNodes.find(dgNodeName);
+  if(it == mDGNodes.end())
+    return requireEvaluate();
+
+  bool result = markDGNodeDirty(it->second) || !mRequiresEval;
+  mRequiresEval = true;
+  return result;
+}
+
+DGGraphImpl::DGNodeIt DGGraphImpl::findDGNode(FabricCore::DGNode dgNode)
+{
+  // the default DGNode is the common case
+  DGNodeIt it = mDGNodes.find(mDGNodeDefaultName);
+  if(it != mDGNodes.end() && strcmp(it->second.node.getName(), dgNode.getName()) == 0)
+    return it;
+  for(it = mDGNodes.begin(); it != mDGNodes.end(); it++)
+  {
+    if(strcmp(it->second.node.getName(), dgNode.getName()) == 0)
+      return it;
+  }
+  return mDGNodes.end();
+}
+
+bool DGGraphImpl::markDGNodeDirty(DGNodeData & data)
+{
+  // dependents of a dirty node are dirty already
+  if(data.dirty)
+    return false;
+  data.dirty = true;
+  data.node.setDirty();
+  for(size_t i=0;i<data.dependents.size();i++)
+  {
+    DGNodeIt it = mDGNodes.find(data.dependents[i]);
+    if(it != mDGNodes.end())
+      markDGNodeDirty(it->second);
+  }
   return true;
 }
 
+void DGGraphImpl::updateRequiresEval()
+{
+  mRequiresEval = false;
+  for(DGNodeIt it = mDGNodes.begin(); it != mDGNodes.end(); it++)
+  {
+    if(it->second.dirty)
+    {
+      mRequiresEval = true;
+      return;
+    }
+  }
+}
+
 char const * DGGraphImpl::getRealDGOperatorName(const char * name) const
 {
   stringConstIt it = mDGOperatorNameMap.find(name);
@@ -4,14 +4,22 @@
 #define __FabricSpliceImpl_DGGRAPHIMPL_H__
 
 #include "DGPortImpl.h"
+#include "DGEvaluationImpl.h"
 #include "SceneManagementImpl.h"
 #include <FabricCore.h>
 
+#ifndef NDEBUG
+#include <boost/atomic.hpp>
+#endif
+
 namespace FabricSpliceImpl
 {
   class DGGraphImpl : public ObjectImpl
   {
     friend class SceneManagementImpl;
+    friend class DGEvaluationImpl;
+    friend class DGPortImpl;
+    friend class DGPortIOPlanImpl;
 
   public:
 
@@ -46,6 +54,24 @@ namespace FabricSpliceImpl
     /// returns the client
     static const FabricCore::Client * getClient();
 
+    /// returns the slot of this graph in the graph registry
+    uint32_t getSlot() const { return mSlot; }
+
+    /// returns the generation of this graph's registry slot. the generation
+    /// changes when the graph is destroyed, so a slot and generation pair
+    /// identifies the graph without holding a (weak) reference to it.
+    uint32_t getGeneration() const { return sSlots[mSlot].generation; }
+
+    /// returns the graph for a given slot and generation, or NULL if
+    /// the graph has been destroyed in the meantime. the graph isn't kept
+    /// alive by this, so graphs must not be destroyed while another thread
+    /// is using them through their DGPorts.
+    static DGGraphImpl * resolveSlot(uint32_t slot, uint32_t generation)
+    {
+      const Slot & s = sSlots[slot];
+      return s.generation == generation ? s.graph : NULL;
+    }
+
     /// retrieve the user pointer
     void * getUserPointer();
 
@@ -190,6 +216,10 @@ namespace FabricSpliceImpl
     /// checks all FabricCore::DGNodes and FabricCore::Operators for errors, return false if any errors found
     static bool checkErrors(std::string * errorOut = NULL);
 
+    /// checks the FabricCore::DGNodes, bindings and operators of this graph for errors, return false
+    /// if any errors found. only what changed since the last check is checked again.
+    bool checkGraphErrors(std::string * errorOut = NULL);
+
     /// set whether to evaluate using a shared lock
     void setEvaluateShared( bool evaluateShared )
         { mEvaluateShared = evaluateShared; }
@@ -200,12 +230,56 @@ namespace FabricSpliceImpl
         std::string * errorOut = NULL
         );
 
-    /// evaluates a FabricCore::DGNode based on its name
+    /// evaluates a FabricCore::DGNode based on its name, or all DGNodes if the name is empty.
+    /// dirty dependencies are evaluated level by level. if the graph evaluates shared,
+    /// DGNodes without a dependency path between them are evaluated concurrently on
+    /// the host thread pool, otherwise one after the other.
     bool evaluate(
         const std::string & name = "",
         std::string * errorOut = NULL
         );
 
+    /// evaluates a list of FabricCore::DGNodes, checking for errors only once
+    bool evaluate(
+        const std::vector<FabricCore::DGNode> & dgNodes,
+        std::string * errorOut = NULL
+        );
+
+    /// evaluates the dirty DGNodes of several DGGraphs in dependency order, checking
+    /// for errors only once. if parallel is true the graphs evaluating shared (see
+    /// setEvaluateShared) are spread across the host thread pool, the others are
+    /// evaluated one after the other on the calling thread.
+    /// results receives the status of each graph, errors are reported per graph.
+    /// graphs listed more than once are evaluated once and share their result.
+    static bool evaluateAll(
+        const std::vector<DGGraphImplPtr> & graphs,
+        bool parallel = true,
+        bool * results = NULL,
+        std::string * errorOut = NULL
+        );
+
+    /// evaluates all dirty DGNodes on a background thread and returns the handle of the
+    /// evaluation, or an empty pointer if the graph has errors. func is called once the
+    /// evaluation is done. a new evaluation supersedes the one in flight, the DGNodes it
+    /// didn't get to stay dirty. graphs meant to be evaluated asynchronously should use a
+    /// client constructed with FabricCore::ClientOptimizationType_Background.
+    /// while an evaluation is in flight, reading a DGPort waits for it to finish,
+    /// writing a DGPort or changing the graph cancels it first.
+    DGEvaluationImplPtr evaluateAsync(
+        DGEvaluationImpl::CompletedFunc func = NULL,
+        void * userData = NULL,
+        std::string * errorOut = NULL
+        );
+
+    /// returns true if an asynchronous evaluation is in flight
+    bool isEvaluating() const { return mEvaluation.get() != NULL; }
+
+    /// waits for the asynchronous evaluation in flight, returns false if it failed
+    bool waitForEvaluation(std::string * errorOut = NULL);
+
+    /// cancels the asynchronous evaluation in flight and waits for it to stop
+    void cancelEvaluation() { if(mEvaluation) collectEvaluation(true); }
+
     /// clears the evaluation state
     bool clearEvaluate(std::string * errorOut = NULL);
 
@@ -291,9 +365,13 @@ namespace FabricSpliceImpl
     /// returns the splice reference file path
     const char * getReferencedFilePath();
 
-    /// request an evaluation on idle
+    /// request an evaluation on idle, dirtying all DGNodes
     bool requireEvaluate();
 
+    /// request an evaluation on idle, dirtying only the given DGNode and
+    /// all DGNodes depending on it (see setDGNodeDependency)
+    bool requireEvaluate(const std::string & dgNode);
+
     /// complex data types and arrays are not persisted, use this to override the default behaviour 
     void setMemberPersistence(const std::string &name, bool persistence);
 
@@ -305,8 +383,21 @@ namespace FabricSpliceImpl
     // disable copy constructor
     DGGraphImpl(const DGGraphImpl& that) {}
 
-    // fire an evaluation on idle
-    static void requireDGCheck() { sDGCheckRequired = true; }
+    // an entry of the graph registry
+    struct Slot
+    {
+      DGGraphImpl * graph;
+      uint32_t generation;
+    };
+
+    // requires all graphs to be checked for errors again
+    static void requireDGCheck() { sDGCheckStamp++; }
+
+    // requires this graph's DGNodes and bindings to be checked for errors again
+    void requireGraphCheck() { mDGCheckRequired = true; }
+
+    /// reads the modified external array buffers bound to any of the DGPorts
+    bool syncExternalArrayData(std::string * errorOut = NULL);
 
     /// marks a given KL operator as invalid
     static bool invalidateKLOperator(const std::string & opName, std::string * errorOut = NULL);
@@ -327,6 +418,9 @@ namespace FabricSpliceImpl
     {
       FabricCore::DGNode node;
       std::vector<FabricCore::Variant> opPortMaps;
+      bool dirty;
+      stringVector dependencies;
+      stringVector dependents;
     };
 
     struct DGBindingData
@@ -336,6 +430,7 @@ namespace FabricSpliceImpl
       bool valid;
       std::string dgNode;
       std::vector<std::string> portName;   
+      uint32_t checkedVersion;
     };
 
     struct DGOperatorParamInfo
@@ -356,6 +451,7 @@ namespace FabricSpliceImpl
       size_t uses;
       std::string entry;
       std::string klCode;
+      uint32_t version;
 
       DGOperatorData(FabricCore::DGOperator inOp, std::string inEntry, std::string inCode)
       {
@@ -363,13 +459,68 @@ namespace FabricSpliceImpl
         uses = 1;
         entry = inEntry;
         klCode = inCode;
+        version = 1;
       }
     };
 
+    // requires an operator and all of its bindings to be checked for errors again
+    static void requireOperatorCheck(DGOperatorData & data) { data.version++; sOperatorCheckStamp++; }
+
     typedef std::map<std::string, DGNodeData> DGNodeMap;
     typedef DGNodeMap::iterator DGNodeIt;
     typedef DGNodeMap::const_iterator DGNodeConstIt;
     typedef std::pair<std::string, DGNodeData> DGNodePair;
+
+    // returns the entry of a given FabricCore::DGNode
+    DGNodeIt findDGNode(FabricCore::DGNode dgNode);
+
+    // marks a DGNode and all of its dependents dirty, returns true if the node was clean
+    bool markDGNodeDirty(DGNodeData & data);
+
+    // updates mRequiresEval from the DGNodes' dirty state
+    void updateRequiresEval();
+
+    // evaluates the given DGNodes and their dirty dependencies level by level
+    bool evaluateDGNodes(const std::vector<FabricCore::DGNode> & dgNodes, std::string * errorOut);
+
+    // groups the given DGNodes and their dirty dependencies into levels,
+    // DGNodes which don't belong to this graph are returned separately
+    void getDGNodeSchedule(
+        const std::vector<FabricCore::DGNode> & dgNodes,
+        std::vector< std::vector<DGNodeIt> > & schedule,
+        std::vector<FabricCore::DGNode> & unknownNodes
+        );
+
+    // returns the level of a dirty DGNode, the length of its longest path of dirty dependencies
+    uint32_t getDGNodeLevel(DGNodeIt it, std::map<std::string, uint32_t> & levels);
+
+    // the DGNodes of a single level of evaluateDGNodes
+    struct EvaluateLevelTask
+    {
+      std::vector<FabricCore::DGNode> nodes;
+      std::vector<std::string> errors;
+      bool shared;
+    };
+
+    // evaluates a single DGNode of a level, this runs on the thread pool
+    static void evaluateLevelTask(void * userData, uint32_t index);
+
+    // the shared graphs of an evaluateAll which are spread across the thread pool
+    struct EvaluateAllTask
+    {
+      std::vector<DGGraphImpl*> graphs;
+      std::vector< std::vector< std::vector<DGNodeIt> > > schedules;
+      std::vector<uint32_t> completedLevels;
+      std::vector<std::string> errors;
+    };
+
+    // evaluates the schedule of a single graph of an evaluateAll level by level. this
+    // runs on the thread pool, errors are stored on the task instead of being reported.
+    static void evaluateAllTask(void * userData, uint32_t index);
+
+    // waits for the asynchronous evaluation in flight, optionally cancelling it
+    // first, and marks the DGNodes of its completed levels clean
+    void collectEvaluation(bool cancel);
     
     typedef std::map<std::string, DGOperatorData> DGOperatorMap;
     typedef DGOperatorMap::iterator DGOperatorIt;
@@ -407,11 +558,23 @@ namespace FabricSpliceImpl
     std::string mFilePath;
     std::string mOriginalName;
     bool mEvaluateShared;
+    uint32_t mSlot;
+    bool mDGCheckRequired;
+    uint32_t mDGCheckStamp;
+    uint32_t mOperatorCheckStamp;
+    DGEvaluationImplPtr mEvaluation;
+#ifndef NDEBUG
+    // DGPort calls in flight, see DGPortImpl::GraphRef
+    boost::atomic<uint32_t> mPortCalls;
+#endif
 
     // static members
+    static std::vector<Slot> sSlots;
+    static std::vector<uint32_t> sFreeSlots;
     static DGOperatorSuffixMap sDGOperatorSuffix;
     static DGOperatorMap sDGOperators;
-    static bool sDGCheckRequired;
+    static uint32_t sDGCheckStamp;
+    static uint32_t sOperatorCheckStamp;
     static unsigned int sInstanceCount;
     static FabricCore::Client * sClient;
     static FabricCore::RTVal sDrawingScope;
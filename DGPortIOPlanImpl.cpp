@@ -0,0 +1,284 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "DGPortIOPlanImpl.h"
+
+using namespace FabricSpliceImpl;
+
+DGPortIOPlanImpl::DGPortIOPlanImpl()
+{
+  mIsValidated = false;
+}
+
+DGPortIOPlanImpl::~DGPortIOPlanImpl()
+{
+}
+
+DGPortIOPlanImplPtr DGPortIOPlanImpl::construct()
+{
+  return DGPortIOPlanImplPtr(new DGPortIOPlanImpl());
+}
+
+bool DGPortIOPlanImpl::addEntry(
+  DGPortImplPtr port,
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  DGPortImpl::Mode mode,
+  std::string * errorOut
+  )
+{
+  if(!port)
+    return LoggingImpl::reportError("DGPortIOPlanImpl::addEntry, DGPort is not valid.", errorOut);
+  if(mode == DGPortImpl::Mode_IO)
+    return LoggingImpl::reportError("DGPortIOPlanImpl::addEntry, an entry has to be either an input or an output.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+
+  Entry entry;
+  entry.port = port;
+  entry.buffer = buffer;
+  entry.bufferSize = bufferSize;
+  entry.slice = slice;
+  entry.mode = mode;
+  entry.dataSize = 0;
+  entry.isArray = false;
+  entry.graphIndex = 0;
+  mEntries.push_back(entry);
+
+  mIsValidated = false;
+  return true;
+}
+
+bool DGPortIOPlanImpl::setEntryBuffer(
+  uint32_t index,
+  void * buffer,
+  uint32_t bufferSize,
+  std::string * errorOut
+  )
+{
+  if(index >= mEntries.size())
+    return LoggingImpl::reportError("DGPortIOPlanImpl::setEntryBuffer, index out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+
+  Entry & entry = mEntries[index];
+  if(mIsValidated && (bufferSize % entry.dataSize) != 0)
+    return LoggingImpl::reportError("DGPort '"+entry.port->getName()+"': Invalid buffer size.", errorOut);
+
+  entry.buffer = buffer;
+  entry.bufferSize = bufferSize;
+  return true;
+}
+
+void DGPortIOPlanImpl::clear()
+{
+  mEntries.clear();
+  mGraphs.clear();
+  mIsValidated = false;
+}
+
+bool DGPortIOPlanImpl::validate(std::string * errorOut)
+{
+  mIsValidated = false;
+  mGraphs.clear();
+
+  for(size_t i=0;i<mEntries.size();i++)
+  {
+    Entry & entry = mEntries[i];
+    DGPortImplPtr port = entry.port;
+    std::string prefix = "DGPort '"+port->getName()+"': ";
+
+    if(entry.mode == DGPortImpl::Mode_IN && port->getMode() == DGPortImpl::Mode_OUT)
+      return LoggingImpl::reportError(prefix+"Cannot set data on an output DGPort.", errorOut);
+    if(entry.mode == DGPortImpl::Mode_OUT && port->getMode() == DGPortImpl::Mode_IN)
+      return LoggingImpl::reportError(prefix+"Cannot get data on an input DGPort.", errorOut);
+    if(!port->isShallow())
+      return LoggingImpl::reportError(prefix+"DGPort is not shallow.", errorOut);
+    if(port->hasArrayDataCopy())
+      return LoggingImpl::reportError(prefix+"DGPort holds a copy of its array data.", errorOut);
+
+    DGGraphImplPtr graph = port->getDGGraph();
+    if(!graph)
+      return LoggingImpl::reportError("DGPortIOPlanImpl::validate, Node '"+port->mGraphName+"' already destroyed.", errorOut);
+
+    // the sizes below are read from the DGNodes, so wait for the evaluation
+    // in flight. cancelling it is left to execute.
+    if(graph->isEvaluating())
+      graph->collectEvaluation(false);
+
+    entry.dgNode = port->mDGNode;
+    entry.dataSize = port->getDataSize();
+    entry.isArray = port->isArray();
+
+    if(entry.dataSize == 0 || (entry.bufferSize % entry.dataSize) != 0)
+      return LoggingImpl::reportError(prefix+"Invalid buffer size.", errorOut);
+
+    if(entry.isArray)
+    {
+      if(entry.slice >= entry.dgNode.getSize())
+        return LoggingImpl::reportError(prefix+"Slice out of bounds.", errorOut);
+    }
+    else if(entry.dgNode.getSize() * entry.dataSize != entry.bufferSize)
+      return LoggingImpl::reportError(prefix+"Buffer size does not match slice count.", errorOut);
+
+    // two inputs targetting the same storage would silently overwrite each other
+    if(entry.mode == DGPortImpl::Mode_IN)
+    {
+      for(size_t j=0;j<i;j++)
+      {
+        const Entry & other = mEntries[j];
+        if(other.mode != DGPortImpl::Mode_IN || other.port != entry.port)
+          continue;
+        if(!entry.isArray || other.slice == entry.slice)
+          return LoggingImpl::reportError(prefix+"DGPort is written more than once.", errorOut);
+      }
+    }
+
+    size_t graphIndex = mGraphs.size();
+    for(size_t j=0;j<mGraphs.size();j++)
+    {
+      if(DGGraphImplPtr(mGraphs[j].graph) == graph)
+      {
+        graphIndex = j;
+        break;
+      }
+    }
+    if(graphIndex == mGraphs.size())
+    {
+      GraphData data;
+      data.graph = graph;
+      data.graphName = graph->getName();
+      mGraphs.push_back(data);
+    }
+    entry.graphIndex = graphIndex;
+
+    GraphData & graphData = mGraphs[graphIndex];
+    if(entry.mode != DGPortImpl::Mode_IN)
+    {
+      bool found = false;
+      for(size_t j=0;j<graphData.outputDGNodeNames.size();j++)
+      {
+        if(graphData.outputDGNodeNames[j] == port->getDGNodeName())
+        {
+          found = true;
+          break;
+        }
+      }
+      if(!found)
+      {
+        graphData.outputDGNodeNames.push_back(port->getDGNodeName());
+        graphData.outputDGNodes.push_back(entry.dgNode);
+      }
+    }
+  }
+
+  mIsValidated = true;
+  return true;
+}
+
+bool DGPortIOPlanImpl::execute(std::string * errorOut)
+{
+  if(!mIsValidated)
+  {
+    if(!validate(errorOut))
+      return false;
+  }
+
+  std::vector<DGGraphImplPtr> graphs(mGraphs.size());
+  for(size_t i=0;i<mGraphs.size();i++)
+  {
+    if(mGraphs[i].graph.expired())
+    {
+      mIsValidated = false;
+      return LoggingImpl::reportError("DGPortIOPlanImpl::execute, Node '"+mGraphs[i].graphName+"' already destroyed.", errorOut);
+    }
+    graphs[i] = DGGraphImplPtr(mGraphs[i].graph);
+
+    // the entries access the DGNodes directly, so the plan
+    // supersedes any asynchronous evaluation in flight
+    graphs[i]->cancelEvaluation();
+  }
+
+  // only the DGNodes owning the written members and their dependents are dirtied
+  for(size_t i=0;i<mEntries.size();i++)
+  {
+    if(mEntries[i].mode != DGPortImpl::Mode_IN)
+      continue;
+    if(!writeEntry(mEntries[i], errorOut))
+      return false;
+    graphs[mEntries[i].graphIndex]->requireEvaluate(mEntries[i].port->getDGNodeName());
+  }
+
+  for(size_t i=0;i<mGraphs.size();i++)
+  {
+    if(mGraphs[i].outputDGNodes.size() == 0)
+      continue;
+    if(!graphs[i]->evaluate(mGraphs[i].outputDGNodes, errorOut))
+      return false;
+  }
+
+  for(size_t i=0;i<mEntries.size();i++)
+  {
+    if(mEntries[i].mode != DGPortImpl::Mode_OUT)
+      continue;
+    if(!readEntry(mEntries[i], errorOut))
+      return false;
+  }
+
+  return true;
+}
+
+bool DGPortIOPlanImpl::writeEntry(Entry & entry, std::string * errorOut)
+{
+  const char * member = entry.port->getMember();
+  uint32_t bufferCount = entry.bufferSize / entry.dataSize;
+
+  try
+  {
+    if(entry.isArray)
+    {
+      entry.port->resizeArraySlice(entry.slice, bufferCount);
+      if(bufferCount > 0)
+        entry.dgNode.setMemberSliceArrayData(member, entry.slice, entry.bufferSize, entry.buffer);
+    }
+    else
+    {
+      if(entry.dgNode.getSize() != bufferCount)
+        return LoggingImpl::reportError("DGPort '"+entry.port->getName()+"': The buffer size does not match the slice count.", errorOut);
+      entry.dgNode.setMemberAllSlicesData(member, entry.bufferSize, entry.buffer);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+bool DGPortIOPlanImpl::readEntry(Entry & entry, std::string * errorOut)
+{
+  const char * member = entry.port->getMember();
+  uint32_t bufferCount = entry.bufferSize / entry.dataSize;
+
+  try
+  {
+    if(entry.isArray)
+    {
+      if(entry.dgNode.getMemberSliceArraySize(member, entry.slice) != bufferCount)
+        return LoggingImpl::reportError("DGPort '"+entry.port->getName()+"': The buffer size does not match the array size.", errorOut);
+      if(bufferCount > 0)
+        entry.dgNode.getMemberSliceArrayData(member, entry.slice, entry.bufferSize, entry.buffer);
+    }
+    else
+    {
+      if(entry.dgNode.getSize() != bufferCount)
+        return LoggingImpl::reportError("DGPort '"+entry.port->getName()+"': Buffer size does not match slice count.", errorOut);
+      entry.dgNode.getMemberAllSlicesData(member, entry.bufferSize, entry.buffer);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_DGPORTIOPLANIMPL_H__
+#define __FabricSpliceImpl_DGPORTIOPLANIMPL_H__
+
+#include "DGPortImpl.h"
+#include <FabricCore.h>
+
+namespace FabricSpliceImpl
+{
+  class DGPortIOPlanImpl
+  {
+  public:
+
+    /*
+      Constructors / Destructors
+    */
+
+    static DGPortIOPlanImplPtr construct();
+    ~DGPortIOPlanImpl();
+
+    /*
+      Entry management
+    */
+
+    /// adds an entry to the plan. mode has to be either DGPortImpl::Mode_IN (the
+    /// buffer is written into the port) or DGPortImpl::Mode_OUT (the port is read
+    /// into the buffer). for array DGPorts the buffer covers the array of the
+    /// given slice, for non-array DGPorts it covers all slices.
+    /// adding an entry invalidates the plan.
+    bool addEntry(
+        DGPortImplPtr port,
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        DGPortImpl::Mode mode = DGPortImpl::Mode_IN,
+        std::string * errorOut = NULL
+        );
+
+    /// changes the buffer of an existing entry without invalidating the plan
+    bool setEntryBuffer(
+        uint32_t index,
+        void * buffer,
+        uint32_t bufferSize,
+        std::string * errorOut = NULL
+        );
+
+    /// returns the number of entries in the plan
+    uint32_t getEntryCount() const { return (uint32_t)mEntries.size(); }
+
+    /// removes all entries from the plan
+    void clear();
+
+    /*
+      Validation / execution
+    */
+
+    /// performs all mode, shallowness and slice checks for all entries.
+    /// this waits for asynchronous evaluations in flight but doesn't cancel them.
+    bool validate(std::string * errorOut = NULL);
+
+    /// returns true if the plan has been validated since the last change
+    bool isValidated() const { return mIsValidated; }
+
+    /// writes all input entries, evaluates every affected graph once
+    /// and reads all output entries. validates the plan if required.
+    bool execute(std::string * errorOut = NULL);
+
+  private:
+
+    DGPortIOPlanImpl();
+
+    struct Entry
+    {
+      DGPortImplPtr port;
+      void * buffer;
+      uint32_t bufferSize;
+      uint32_t slice;
+      DGPortImpl::Mode mode;
+
+      // cached during validation
+      FabricCore::DGNode dgNode;
+      uint32_t dataSize;
+      bool isArray;
+      size_t graphIndex;
+    };
+
+    struct GraphData
+    {
+      DGGraphImplWeakPtr graph;
+      std::string graphName;
+      stringVector outputDGNodeNames;
+      std::vector<FabricCore::DGNode> outputDGNodes;
+    };
+
+    bool writeEntry(Entry & entry, std::string * errorOut);
+    bool readEntry(Entry & entry, std::string * errorOut);
+
+    std::vector<Entry> mEntries;
+    std::vector<GraphData> mGraphs;
+    bool mIsValidated;
+  };
+};
+
+#endif
@@ -1,10 +1,34 @@
 // Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
 
 #include "DGPortImpl.h"
+#include "BulkIOImpl.h"
+#include "TypeLayoutImpl.h"
+#include "JSONCodecImpl.h"
+#include "ColumnLayoutImpl.h"
 #include "SceneManagementImpl.h"
 
+#include <boost/thread/tss.hpp>
+#include <limits.h>
+
 using namespace FabricSpliceImpl;
 
+// reusable per-thread buffer for copies which can't go through the member storage
+static boost::thread_specific_ptr< std::vector<char> > sScratchBuffer;
+
+// the scratch buffer is released at the end of a transfer which grew it beyond
+// this size, so that a single large transfer doesn't keep its memory per thread
+#define SCRATCH_BUFFER_RETAINED_SIZE (16 * 1024 * 1024)
+
+struct ScratchBufferScope
+{
+  ~ScratchBufferScope()
+  {
+    std::vector<char> * buffer = sScratchBuffer.get();
+    if(buffer != NULL && buffer->size() > SCRATCH_BUFFER_RETAINED_SIZE)
+      sScratchBuffer.reset();
+  }
+};
+
 DGPortImpl::DGPortImpl(
   DGGraphImplPtr graph,
   const std::string & name, 
@@ -19,6 +43,8 @@ DGPortImpl::DGPortImpl(
   const FabricCore::Client * client = DGGraphImpl::getClient();
 
   mGraph = DGGraphImplWeakPtr(graph);
+  mGraphSlot = graph->getSlot();
+  mGraphGeneration = graph->getGeneration();
   mGraphName = graph->getName();
   setName(name);
   mMember = member;
@@ -27,6 +53,13 @@ DGPortImpl::DGPortImpl(
   mMode = mode;
   // mManipulatable = -1;
   mAutoInitObjects = autoInitObjects;
+  mHasArrayCopy = false;
+  mArrayCopyData = NULL;
+  mArrayCopyCount = 0;
+  mArrayCopySlice = 0;
+  mArrayCopyWritable = false;
+  mJSONCodecSupport = -1;
+  mTypeLayoutGeneration = 0;
 
   mKey = StringUtilityImpl::replaceString(mGraphName, '.', '_');
   mKey += "." + StringUtilityImpl::replaceString(getName(), '.', '_');
@@ -37,34 +70,16 @@ DGPortImpl::DGPortImpl(
   if(mIsArray)
     mDataType = mDataType.substr(0, mDataType.length() - 2);
   mDataSize = dataSize;
+  mSliceDataSize = (mIsShallow && !mIsArray) ? mDataSize : 0;
 
-  try
-  {
-    mIsStruct = FabricCore::GetRegisteredTypeIsStruct(*client, mDataType.c_str());
-  }
-  catch(FabricCore::Exception e)
-  {
-    mIsStruct = false;
-  }
-  try
-  {
-    mIsObject = FabricCore::GetRegisteredTypeIsObject(*client, mDataType.c_str());
-  }
-  catch(FabricCore::Exception e)
-  {
-    mIsObject = false;
-  }
-  try
-  {
-    mIsInterface = FabricCore::GetRegisteredTypeIsInterface(*client, mDataType.c_str());
-  }
-  catch(FabricCore::Exception e)
-  {
-    mIsInterface = false;
-  }
+  // the struct, object and interface traits are queried on first use
+  mTypeTraitsResolved = false;
+  mIsStruct = false;
+  mIsObject = false;
+  mIsInterface = false;
 
   // if the DGPort uses a KL object, let's initiate it
-  if(!mIsArray && isObject() && doesAutoInitObjects()) {
+  if(!mIsArray && !mIsShallow && doesAutoInitObjects() && isObject()) {
     try
     {
       FabricCore::RTVal rt = getRTVal();
@@ -86,6 +101,20 @@ DGPortImpl::DGPortImpl(
 
 DGPortImpl::~DGPortImpl()
 {
+  // an array data copy still held on destruction is dropped without writing it back,
+  // the graph might be going away as well
+  if(mHasArrayCopy)
+  {
+    mHasArrayCopy = false;
+    mArrayCopy.invalidate();
+    mArrayCopyData = NULL;
+  }
+  for(ExternalArrayMap::iterator it = mExternalArrays.begin(); it != mExternalArrays.end(); it++)
+  {
+    if(it->second.releaseFunc)
+      (*it->second.releaseFunc)(it->second.data, it->second.userData);
+  }
+  mExternalArrays.clear();
   LoggingImpl::log("DGPort '"+getName()+"' on Node '"+mGraphName+"' destroyed.");
 }
 
@@ -96,12 +125,103 @@ DGGraphImplPtr DGPortImpl::getDGGraph()
   return DGGraphImplPtr(mGraph);
 }
 
+inline DGPortImpl::GraphRef::GraphRef(DGGraphImpl * graph)
+: mGraph(graph)
+{
+#ifndef NDEBUG
+  if(mGraph)
+    mGraph->mPortCalls++;
+#endif
+}
+
+inline DGPortImpl::GraphRef::GraphRef(const GraphRef & other)
+: mGraph(other.mGraph)
+{
+#ifndef NDEBUG
+  if(mGraph)
+    mGraph->mPortCalls++;
+#endif
+}
+
+inline DGPortImpl::GraphRef::~GraphRef()
+{
+#ifndef NDEBUG
+  if(mGraph)
+    mGraph->mPortCalls--;
+#endif
+}
+
+inline DGPortImpl::GraphRef & DGPortImpl::GraphRef::operator=(const GraphRef & other)
+{
+#ifndef NDEBUG
+  if(other.mGraph)
+    other.mGraph->mPortCalls++;
+  if(mGraph)
+    mGraph->mPortCalls--;
+#endif
+  mGraph = other.mGraph;
+  return *this;
+}
+
+inline DGPortImpl::GraphRef DGPortImpl::resolveDGGraph(bool writing) const
+{
+  DGGraphImpl * graph = DGGraphImpl::resolveSlot(mGraphSlot, mGraphGeneration);
+
+  // the KL operators may still be running on the DGNode, writes supersede the
+  // evaluation in flight while reads wait for it. its errors are left to its handle.
+  if(graph != NULL && graph->isEvaluating())
+    graph->collectEvaluation(writing);
+  return GraphRef(graph);
+}
+
+bool DGPortImpl::reportGraphDestroyed(const char * function) const
+{
+  return LoggingImpl::reportError(std::string(function)+", Node '"+mGraphName+"' already destroyed.");
+}
+
+void DGPortImpl::resolveTypeTraits() const
+{
+  if(mTypeTraitsResolved)
+    return;
+  mTypeTraitsResolved = true;
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  try
+  {
+    mIsStruct = FabricCore::GetRegisteredTypeIsStruct(*client, mDataType.c_str());
+  }
+  catch(FabricCore::Exception e)
+  {
+    mIsStruct = false;
+  }
+
+  // objects and interfaces are references, so shallow types are neither
+  if(mIsShallow)
+    return;
+  try
+  {
+    mIsObject = FabricCore::GetRegisteredTypeIsObject(*client, mDataType.c_str());
+  }
+  catch(FabricCore::Exception e)
+  {
+    mIsObject = false;
+  }
+  try
+  {
+    mIsInterface = FabricCore::GetRegisteredTypeIsInterface(*client, mDataType.c_str());
+  }
+  catch(FabricCore::Exception e)
+  {
+    mIsInterface = false;
+  }
+}
+
 uint32_t DGPortImpl::getSliceCount(std::string * errorOut)
 {
-  DGGraphImplPtr node = getDGGraph();
+  GraphRef node = resolveDGGraph();
   if(!node)
   {
-    LoggingImpl::reportError("DGPortImpl::getSliceCount, Node '"+mGraphName+"' already destroyed.");
+    reportGraphDestroyed("DGPortImpl::getSliceCount");
     return 0;
   }
   return mDGNode.getSize();
@@ -109,27 +229,29 @@ uint32_t DGPortImpl::getSliceCount(std::string * errorOut)
 
 bool DGPortImpl::setSliceCount(uint32_t count, std::string * errorOut)
 {
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setSliceCount");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set a slice count on an output DGPort.", errorOut);
+  if(mDGNode.getSize() == count)
+    return true;
   mDGNode.setSize(count);
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setSliceCount, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
 FabricCore::Variant DGPortImpl::getVariant(uint32_t slice, std::string * errorOut)
 {
-  if(slice > getSliceCount())
+  GraphRef node = resolveDGGraph();
+  if(!node)
   {
-    LoggingImpl::reportError("Slice out of bounds.", errorOut);
+    reportGraphDestroyed("DGPortImpl::getVariant");
     return FabricCore::Variant();
   }
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
+  if(slice > getSliceCount())
   {
-    LoggingImpl::reportError("DGPortImpl::getVariant, Node '"+mGraphName+"' already destroyed.");
+    LoggingImpl::reportError("Slice out of bounds.", errorOut);
     return FabricCore::Variant();
   }
 
@@ -151,47 +273,300 @@ FabricCore::Variant DGPortImpl::getVariant(uint32_t slice, std::string * errorOu
 
 bool DGPortImpl::setVariant(FabricCore::Variant value, uint32_t slice, std::string * errorOut)
 {
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setVariant");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
   if(slice > mDGNode.getSize())
     return LoggingImpl::reportError("Slice out of bounds.", errorOut);
 
-  // add missing dictionary members using the previous value
-  if(value.isDict()) {
-    FabricCore::Variant prevValue = getVariant();
-    for(FabricCore::Variant::DictIter keyIter(prevValue); !keyIter.isDone(); keyIter.next())
+  // members missing in a dictionary keep their previous value,
+  // so only the given keys are patched
+  if(value.isDict() && !mIsArray && (isStruct() || StringUtilityImpl::endsWith(mDataType, "]")))
+    return setDictValues(value, slice, errorOut);
+
+  try
+  {
+    // other dictionaries (f.e. for objects) are completed from the previous value
+    if(value.isDict())
     {
-      std::string key = keyIter.getKey()->getStringData();
-      const FabricCore::Variant * newValue = value.getDictValue(key.c_str());
-      if(newValue == NULL) {
-        const FabricCore::Variant * oldValue = keyIter.getValue();
-        value.setDictValue(key.c_str(), *oldValue);
+      FabricCore::Variant prevValue = getVariant(slice);
+      for(FabricCore::Variant::DictIter keyIter(prevValue); !keyIter.isDone(); keyIter.next())
+      {
+        std::string key = keyIter.getKey()->getStringData();
+        if(value.getDictValue(key.c_str()) == NULL)
+          value.setDictValue(key.c_str(), *keyIter.getValue());
       }
     }
+    mDGNode.setMemberSliceData_Variant(mMember.c_str(), slice, value);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::setDictValues(const FabricCore::Variant & values, uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setDictValues");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!values.isDict())
+    return LoggingImpl::reportError("DGPortImpl::setDictValues, value is not a dictionary.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
 
   try
   {
-    mDGNode.setMemberSliceData_Variant(mMember.c_str(), slice, value);
+    // the current value is taken from the member as is, without evaluating
+    FabricCore::RTVal value = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+    bool isDict = value.isDict();
+    std::string elementType;
+    if(isDict)
+    {
+      // KL dictionaries are named ValueType[KeyType]
+      size_t bracket = mDataType.rfind('[');
+      if(bracket == std::string::npos || mDataType.substr(bracket) != "[String]")
+        return LoggingImpl::reportError("DGPort '"+getName()+"': Only dictionaries with String keys can be patched.", errorOut);
+      elementType = mDataType.substr(0, bracket);
+    }
+    else if(!isStruct())
+      return LoggingImpl::reportError("DGPort '"+getName()+"' is neither a struct nor a dictionary.", errorOut);
+
+    const FabricCore::Client * client = DGGraphImpl::getClient();
+    for(FabricCore::Variant::DictIter keyIter(values); !keyIter.isDone(); keyIter.next())
+    {
+      const char * key = keyIter.getKey()->getStringData();
+      std::string json = keyIter.getValue()->getJSONEncoding().getStringData();
+
+      if(isDict)
+      {
+        // existing elements are patched like struct members,
+        // only new keys start from a default element
+        FabricCore::RTVal keyVal = FabricCore::RTVal::ConstructString(*client, key);
+        FabricCore::RTVal elementVal;
+        try
+        {
+          elementVal = value.getDictElement(keyVal);
+        }
+        catch(FabricCore::Exception e)
+        {
+          elementVal.invalidate();
+        }
+        if(!elementVal.isValid())
+          elementVal = FabricCore::RTVal::Construct(*client, elementType.c_str(), 0, 0);
+        elementVal.setJSON(json.c_str());
+        value.setDictElement(keyVal, elementVal);
+      }
+      else
+      {
+        FabricCore::RTVal memberVal = value.maybeGetMemberRef(key);
+        if(!memberVal.isValid())
+          return LoggingImpl::reportError("DGPort '"+getName()+"': Type '"+mDataType+"' has no member '"+std::string(key)+"'.", errorOut);
+        memberVal.setJSON(json.c_str());
+      }
+    }
+
+    mDGNode.setMemberSliceValue(mMember.c_str(), slice, value);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::removeDictValue(const std::string & key, uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::removeDictValue");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+  try
+  {
+    FabricCore::RTVal value = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+    if(!value.isDict())
+      return LoggingImpl::reportError("DGPort '"+getName()+"' is not a dictionary.", errorOut);
+
+    const FabricCore::Client * client = DGGraphImpl::getClient();
+    FabricCore::RTVal keyVal = FabricCore::RTVal::ConstructString(*client, key.c_str());
+    value.callMethod("", "delete", 1, &keyVal);
+    mDGNode.setMemberSliceValue(mMember.c_str(), slice, value);
   }
   catch(FabricCore::Exception e)
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
-  DGGraphImplPtr node = getDGGraph();
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+FabricCore::Variant DGPortImpl::getVariants(uint32_t start, uint32_t count, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph();
+  if(!node)
+  {
+    reportGraphDestroyed("DGPortImpl::getVariants");
+    return FabricCore::Variant();
+  }
+  uint32_t sliceCount = mDGNode.getSize();
+  if(start > sliceCount || count > sliceCount - start)
+  {
+    LoggingImpl::reportError("Slice out of bounds.", errorOut);
+    return FabricCore::Variant();
+  }
+
+  if(mMode != Mode_IN)
+    if(!node->evaluate(mDGNode, errorOut))
+      return FabricCore::Variant();
+
+  try
+  {
+    FabricCore::Variant result = FabricCore::Variant::CreateArray(count);
+    for(uint32_t i=0;i<count;i++)
+      result.arrayAppend(mDGNode.getMemberSliceData_Variant(mMember.c_str(), start + i));
+    return result;
+  }
+  catch(FabricCore::Exception e)
+  {
+    LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return FabricCore::Variant();
+}
+
+bool DGPortImpl::setAllSlicesFromVariantArray(const FabricCore::Variant & values, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
   if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setVariant, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+    return reportGraphDestroyed("DGPortImpl::setAllSlicesFromVariantArray");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!values.isArray())
+    return LoggingImpl::reportError("DGPortImpl::setAllSlicesFromVariantArray, value is not an array.", errorOut);
+
+  try
+  {
+    uint32_t count = values.getArraySize();
+    if(mDGNode.getSize() != count)
+      mDGNode.setSize(count);
+
+    for(uint32_t i=0;i<count;i++)
+    {
+      const FabricCore::Variant * element = values.getArrayElement(i);
+      if(!element->isDict())
+      {
+        mDGNode.setMemberSliceData_Variant(mMember.c_str(), i, *element);
+        continue;
+      }
+
+      // add missing dictionary members using the previous value of the slice
+      FabricCore::Variant value = *element;
+      FabricCore::Variant prevValue = mDGNode.getMemberSliceData_Variant(mMember.c_str(), i);
+      for(FabricCore::Variant::DictIter keyIter(prevValue); !keyIter.isDone(); keyIter.next())
+      {
+        std::string key = keyIter.getKey()->getStringData();
+        if(value.getDictValue(key.c_str()) == NULL)
+          value.setDictValue(key.c_str(), *keyIter.getValue());
+      }
+      mDGNode.setMemberSliceData_Variant(mMember.c_str(), i, value);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
 std::string DGPortImpl::getJSON(uint32_t slice, std::string * errorOut)
 {
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+  {
+    reportGraphDestroyed("DGPortImpl::getJSON");
+    return "";
+  }
   if(mMode == Mode_IN)
   {
     LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
     return "";
   }
+
+  // shallow values are encoded straight from the member storage
+  TypeLayoutImplPtr layout = getJSONLayout();
+  if(layout && (mIsArray || mDGNode.getSize() == 1))
+  {
+    if(slice >= mDGNode.getSize())
+    {
+      LoggingImpl::reportError("Slice out of bounds.", errorOut);
+      return "";
+    }
+    if(!node->evaluate(mDGNode, errorOut))
+      return "";
+
+    // values JSON can't represent (NaN, infinity) are left to FabricCore's encoding
+    std::string json;
+    std::string encodeError;
+    bool encoded = false;
+    try
+    {
+      if(mIsArray)
+      {
+        FabricCore::RTVal arrayVal;
+        uint32_t count = 0;
+        void * storage = NULL;
+        try
+        {
+          storage = accessArrayStorage(arrayVal, slice, count);
+        }
+        catch(FabricCore::Exception e)
+        {
+          storage = NULL;
+          count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+          if(count > 0)
+          {
+            storage = getScratchBuffer(count * mDataSize);
+            mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+          }
+        }
+        encoded = JSONCodecImpl::encode(json, layout, storage, count, true, &encodeError);
+      }
+      else
+      {
+        void * storage = getScratchBuffer(mDataSize);
+        mDGNode.getMemberAllSlicesData(mMember.c_str(), mDataSize, storage);
+        encoded = JSONCodecImpl::encode(json, layout, storage, 1, false, &encodeError);
+      }
+    }
+    catch(FabricCore::Exception e)
+    {
+      LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+      return "";
+    }
+    if(encoded)
+      return json;
+    LoggingImpl::clearError();
+  }
+
   FabricCore::Variant result = getVariant(slice, errorOut);
   if(result.isNull())
     return "";
@@ -200,8 +575,63 @@ std::string DGPortImpl::getJSON(uint32_t slice, std::string * errorOut)
 
 bool DGPortImpl::setJSON(const std::string & json, uint32_t slice, std::string * errorOut)
 {
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setJSON");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+
+  // shallow values are decoded straight into the member storage
+  TypeLayoutImplPtr layout = getJSONLayout();
+  if(layout && (mIsArray || mDGNode.getSize() == 1))
+  {
+    if(slice >= mDGNode.getSize())
+      return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+    try
+    {
+      // array elements start out zeroed like new KL values, single values
+      // keep the members which aren't part of the JSON
+      std::vector<char> data;
+      if(!mIsArray)
+      {
+        data.resize(mDataSize);
+        mDGNode.getMemberAllSlicesData(mMember.c_str(), mDataSize, &data[0]);
+      }
+
+      // JSON the codec doesn't accept (f.e. null for NaN) is left to FabricCore,
+      // which also reports the errors for invalid JSON
+      std::string decodeError;
+      if(!JSONCodecImpl::decode(json.c_str(), layout, data, mIsArray, &decodeError))
+      {
+        LoggingImpl::clearError();
+        return setJSONVariant(json, slice, errorOut);
+      }
+
+      if(mIsArray)
+      {
+        uint32_t count = (uint32_t)(data.size() / mDataSize);
+        resizeArraySlice(slice, count);
+        if(count > 0)
+          mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, &data[0]);
+      }
+      else
+        mDGNode.setMemberAllSlicesData(mMember.c_str(), mDataSize, &data[0]);
+    }
+    catch(FabricCore::Exception e)
+    {
+      return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+    }
+
+    node->requireEvaluate(mDGNodeName);
+    return true;
+  }
+
+  return setJSONVariant(json, slice, errorOut);
+}
+
+bool DGPortImpl::setJSONVariant(const std::string & json, uint32_t slice, std::string * errorOut)
+{
   try
   {
     FabricCore::Variant variant = FabricCore::Variant::CreateFromJSON(json);
@@ -211,23 +641,19 @@ bool DGPortImpl::setJSON(const std::string & json, uint32_t slice, std::string *
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setJSON, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
   return false;
 }
 
 FabricCore::Variant DGPortImpl::getDefault(std::string * errorOut)
 {
   FabricCore::Variant result;
-  if(mIsObject)
+  if(isObject())
     return result;
 
-  DGGraphImplPtr node = getDGGraph();
+  GraphRef node = resolveDGGraph();
   if(!node)
   {
-    LoggingImpl::reportError("DGPortImpl::getDefault, Node '"+mGraphName+"' already destroyed.");
+    reportGraphDestroyed("DGPortImpl::getDefault");
     return result;
   }
 
@@ -251,15 +677,15 @@ FabricCore::RTVal DGPortImpl::getRTVal(
   std::string * errorOut
   )
 {
-  if(slice > getSliceCount())
+  GraphRef node = resolveDGGraph();
+  if(!node)
   {
-    LoggingImpl::reportError("Slice out of bounds.", errorOut);
+    reportGraphDestroyed("DGPortImpl::getRTVal");
     return FabricCore::RTVal();
   }
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
+  if(slice > getSliceCount())
   {
-    LoggingImpl::reportError("DGPortImpl::getRTVal, Node '"+mGraphName+"' already destroyed.");
+    LoggingImpl::reportError("Slice out of bounds.", errorOut);
     return FabricCore::RTVal();
   }
 
@@ -280,12 +706,48 @@ FabricCore::RTVal DGPortImpl::getRTVal(
   return FabricCore::RTVal();
 }
 
-bool DGPortImpl::setRTVal(
-  FabricCore::RTVal value,
-  uint32_t slice,
+bool DGPortImpl::getRTVals(
+  FabricCore::RTVal * results,
+  uint32_t start,
+  uint32_t count,
+  bool evaluate,
   std::string * errorOut
   )
 {
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getRTVals");
+  if(results == NULL && count != 0)
+    return LoggingImpl::reportError("No valid results provided.", errorOut);
+  uint32_t sliceCount = mDGNode.getSize();
+  if(start > sliceCount || count > sliceCount - start)
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+  if(mMode != Mode_IN && evaluate)
+    if(!node->evaluate(mDGNode, errorOut))
+      return false;
+
+  try
+  {
+    for(uint32_t i=0;i<count;i++)
+      results[i] = mDGNode.getMemberSliceValue(mMember.c_str(), start + i);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+bool DGPortImpl::setRTVal(
+  FabricCore::RTVal value,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setRTVal");
   // if(mMode == Mode_OUT)
   //   return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
   if(slice > mDGNode.getSize())
@@ -299,15 +761,18 @@ bool DGPortImpl::setRTVal(
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setRTVal, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
 uint32_t DGPortImpl::getArrayCount(uint32_t slice, std::string * errorOut)
 {
+  GraphRef node = resolveDGGraph();
+  if(!node)
+  {
+    reportGraphDestroyed("DGPortImpl::getArrayCount");
+    return 0;
+  }
   if(mMode == Mode_IN)
   {
     LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
@@ -321,12 +786,6 @@ uint32_t DGPortImpl::getArrayCount(uint32_t slice, std::string * errorOut)
     LoggingImpl::reportError("Slice out of bounds.", errorOut);
     return 0;
   }
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-  {
-    LoggingImpl::reportError("DGPortImpl::getArrayCount, Node '"+mGraphName+"' already destroyed.");
-    return 0;
-  }
   if(!node->evaluate(mDGNode, errorOut))
     return 0;
 
@@ -349,6 +808,9 @@ bool DGPortImpl::getArrayData(
   std::string * errorOut
   )
 {
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayData");
   if(mMode == Mode_IN)
     return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
   if(!mIsArray)
@@ -359,9 +821,6 @@ bool DGPortImpl::getArrayData(
     return LoggingImpl::reportError("Slice out of bounds.", errorOut);
   if(buffer == NULL && bufferSize != 0)
     return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::getArrayData, Node '"+mGraphName+"' already destroyed.");
   if(!node->evaluate(mDGNode, errorOut))
     return false;
 
@@ -400,6 +859,9 @@ bool DGPortImpl::setArrayData(
   std::string * errorOut
   )
 {
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayData");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
   if(!mIsArray)
@@ -417,8 +879,7 @@ bool DGPortImpl::setArrayData(
 
   try
   {
-    if ( mDGNode.getMemberSliceArraySize( mMember.c_str(), slice ) != bufferCount )
-      mDGNode.setMemberSliceArraySize( mMember.c_str(), slice, bufferCount );
+    resizeArraySlice(slice, bufferCount);
     if(bufferCount >  0)
       mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, bufferSize, buffer);
   }
@@ -427,36 +888,60 @@ bool DGPortImpl::setArrayData(
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setArrayData, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
-bool DGPortImpl::getAllSlicesData(void * buffer, uint32_t bufferSize, std::string * errorOut)
+bool DGPortImpl::getArrayDataRange(
+  void * buffer,
+  uint32_t offset,
+  uint32_t count,
+  uint32_t slice,
+  std::string * errorOut
+  )
 {
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayDataRange");
   if(mMode == Mode_IN)
     return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
-  if(mIsArray)
-    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
   if(!mIsShallow)
     return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
-  if(buffer == NULL && bufferSize != 0)
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && count != 0)
     return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::getAllSlicesData, Node '"+mGraphName+"' already destroyed.");
   if(!node->evaluate(mDGNode, errorOut))
     return false;
 
-  uint32_t sliceCount = mDGNode.getSize();
-  if(sliceCount * mDataSize != bufferSize)
-    return LoggingImpl::reportError("Buffer size does not match slice count.", errorOut);
-
   try
   {
-    mDGNode.getMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+    FabricCore::RTVal arrayVal;
+    uint32_t arrayCount = 0;
+    void * storage = NULL;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, arrayCount);
+    }
+    catch(FabricCore::Exception e)
+    {
+      storage = NULL;
+      arrayCount = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if(arrayCount > 0 && count > 0 && offset < arrayCount && count <= arrayCount - offset)
+      {
+        storage = getScratchBuffer(arrayCount * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
+      }
+    }
+
+    if(offset > arrayCount || count > arrayCount - offset)
+      return LoggingImpl::reportError("The range exceeds the array size.", errorOut);
+    // the range lands in the host's buffer, so this is the one copy which can be split
+    if(count > 0)
+      BulkIOImpl::copy(buffer, (const char*)storage + (size_t)offset * mDataSize, (uint64_t)count * mDataSize);
   }
   catch(FabricCore::Exception e)
   {
@@ -466,194 +951,1989 @@ bool DGPortImpl::getAllSlicesData(void * buffer, uint32_t bufferSize, std::strin
   return true;
 }
 
-bool DGPortImpl::setAllSlicesData(void * buffer, uint32_t bufferSize, std::string * errorOut)
+bool DGPortImpl::setArrayDataRange(
+  void * buffer,
+  uint32_t offset,
+  uint32_t count,
+  uint32_t slice,
+  std::string * errorOut
+  )
 {
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayDataRange");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
-  if(mIsArray)
-    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
   if(!mIsShallow)
     return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
-  if(buffer == NULL && bufferSize != 0)
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && count != 0)
     return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
 
-  uint32_t sliceCount = mDGNode.getSize();
-  uint32_t bufferCount = bufferSize / mDataSize;
-  if(bufferCount * mDataSize != bufferSize)
-    return LoggingImpl::reportError("Invalid buffer size.", errorOut);
-  if(bufferCount != sliceCount)
-    return LoggingImpl::reportError("The buffer size does not match the slice count.", errorOut);
-
   try
   {
-    mDGNode.setMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+    uint32_t arrayCount = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+    if(offset > arrayCount || count > arrayCount - offset)
+      return LoggingImpl::reportError("The range exceeds the array size.", errorOut);
+    if(count == 0)
+      return true;
+
+    // FabricCore can only write whole arrays, so the range is patched
+    // into a copy of the array which is then written back
+    void * storage = getScratchBuffer(arrayCount * mDataSize);
+    mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
+    memcpy((char*)storage + (size_t)offset * mDataSize, buffer, (size_t)count * mDataSize);
+    mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
   }
   catch(FabricCore::Exception e)
   {
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::setAllSlicesData, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
-bool DGPortImpl::copyArrayDataFromDGPort(DGPortImplPtr other, uint32_t slice, uint32_t otherSliceHint, std::string * errorOut)
+bool DGPortImpl::gatherArrayData(
+  const uint32_t * indices,
+  uint32_t indexCount,
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
 {
-  if(mMode == Mode_OUT)
-    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::gatherArrayData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
   if(!mIsArray)
     return LoggingImpl::reportError("DGPort is not an array.", errorOut);
   if(!mIsShallow)
     return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
-  if(!other)
-    return LoggingImpl::reportError("Other DGPort is not valid.", errorOut);
-  if(other->mMode == Mode_IN)
-    return LoggingImpl::reportError("Other DGPort is not an out DGPort.", errorOut);
-  if(!other->mIsShallow)
-    return LoggingImpl::reportError("Other DGPort is not shallow.", errorOut);
-  if(!other->mIsArray)
-    return LoggingImpl::reportError("Other DGPort is not an array.", errorOut);
-  if(other->mDataType != mDataType)
-    return LoggingImpl::reportError("DGPorts' data types don't match.", errorOut);
-  if(other->mDataSize != mDataSize)
-    return LoggingImpl::reportError("DGPorts' data sizes don't match.", errorOut);
-  if(slice > getSliceCount())
+  if(slice >= mDGNode.getSize())
     return LoggingImpl::reportError("Slice out of bounds.", errorOut);
-
-  DGGraphImplPtr otherNode = other->getDGGraph();
-  if(!otherNode)
-    return LoggingImpl::reportError("DGPortImpl::copyArrayDataFromDGPort, Node '"+other->mGraphName+"' already destroyed.");
-  if(!otherNode->evaluate(other->mDGNode, errorOut))
+  if(indices == NULL && indexCount != 0)
+    return LoggingImpl::reportError("No valid indices provided.", errorOut);
+  if((buffer == NULL && indexCount != 0) || bufferSize != (uint64_t)indexCount * mDataSize)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  if(indexCount == 0)
+    return true;
+  if(!node->evaluate(mDGNode, errorOut))
     return false;
 
-  uint32_t otherSlice = otherSliceHint;
-  if(otherSlice == UINT_MAX)
-    otherSlice = slice;
-  if(otherSlice > other->getSliceCount())
-    return LoggingImpl::reportError("Other DGPort's slice out of bounds.", errorOut);
-
-  uint32_t arrayCount = 0;
   try
   {
-    arrayCount = other->mDGNode.getMemberSliceArraySize(other->mMember.c_str(), otherSlice);
-  }
-  catch(FabricCore::Exception e)
-  {
-    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
-  }
-
-  uint32_t bufferSize = mDataSize * arrayCount;
-  void * buffer = NULL;
-
-  if(bufferSize > 0)
-  {
-    buffer = malloc(bufferSize);
+    FabricCore::RTVal arrayVal;
+    uint32_t arrayCount = 0;
+    void * storage = NULL;
     try
     {
-      other->mDGNode.getMemberSliceArrayData(
-        other->mMember.c_str(), otherSlice, bufferSize, buffer
-        );
+      storage = accessArrayStorage(arrayVal, slice, arrayCount);
     }
     catch(FabricCore::Exception e)
     {
-      free(buffer);
-      return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+      storage = NULL;
+      arrayCount = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if(arrayCount > 0)
+      {
+        storage = getScratchBuffer(arrayCount * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
+      }
     }
-  }
 
-  try
-  {
-    mDGNode.setMemberSliceArraySize(mMember.c_str(), slice, arrayCount);
-    if(bufferSize >  0)
-      mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, bufferSize, buffer);
+    if(arrayCount == 0 || BulkIOImpl::getMaxIndex(indices, indexCount) >= arrayCount)
+      return LoggingImpl::reportError("Index out of bounds.", errorOut);
+    BulkIOImpl::gatherIndexed(buffer, storage, indices, indexCount, mDataSize);
   }
   catch(FabricCore::Exception e)
   {
-    free(buffer);
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  free(buffer);
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::copyArrayDataFromDGPort, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
   return true;
 }
 
-bool DGPortImpl::copyAllSlicesDataFromDGPort(DGPortImplPtr other, bool resizeTarget, std::string * errorOut)
+bool DGPortImpl::scatterArrayData(
+  const uint32_t * indices,
+  uint32_t indexCount,
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
 {
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::scatterArrayData");
   if(mMode == Mode_OUT)
     return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
-  if(mIsArray)
-    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
   if(!mIsShallow)
     return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
-  if(!other)
-    return LoggingImpl::reportError("Other DGPort is not valid.", errorOut);
-  if(other->mMode == Mode_IN)
-    return LoggingImpl::reportError("Other DGPort is not an out DGPort.", errorOut);
-  if(!other->mIsShallow)
-    return LoggingImpl::reportError("Other DGPort is not shallow.", errorOut);
-  if(other->mIsArray)
-    return LoggingImpl::reportError("Other DGPort is an array.", errorOut);
-  if(other->mDataType != mDataType)
-    return LoggingImpl::reportError("DGPorts' data types don't match.", errorOut);
-  if(other->mDataSize != mDataSize)
-    return LoggingImpl::reportError("DGPorts' data sizes don't match.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(indices == NULL && indexCount != 0)
+    return LoggingImpl::reportError("No valid indices provided.", errorOut);
+  if((buffer == NULL && indexCount != 0) || bufferSize != (uint64_t)indexCount * mDataSize)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  if(indexCount == 0)
+    return true;
 
-  uint32_t sliceCount = other->mDGNode.getSize();
-  if(sliceCount != mDGNode.getSize())
+  try
   {
-    if(resizeTarget)
-      mDGNode.setSize(sliceCount);
-    else
-      return LoggingImpl::reportError("Slice counts don't match.", errorOut);
+    // all indices are checked up front so a failing call leaves the array untouched
+    uint32_t arrayCount = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+    if(arrayCount == 0 || BulkIOImpl::getMaxIndex(indices, indexCount) >= arrayCount)
+      return LoggingImpl::reportError("Index out of bounds.", errorOut);
+
+    // FabricCore can only write whole arrays, so the elements are scattered
+    // into a copy of the array which is then written back
+    void * storage = getScratchBuffer(arrayCount * mDataSize);
+    mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
+    BulkIOImpl::scatterIndexed(storage, buffer, indices, indexCount, mDataSize);
+    mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, arrayCount * mDataSize, storage);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  if(sliceCount == 0)
-    return true;
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
 
-  DGGraphImplPtr otherNode = other->getDGGraph();
-  if(!otherNode)
-    return LoggingImpl::reportError("DGPortImpl::copyAllSlicesDataFromDGPort, Node '"+other->mGraphName+"' already destroyed.");
-  if(!otherNode->evaluate(other->mDGNode, errorOut))
+bool DGPortImpl::getArrayDataStrided(
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t stride,
+  uint32_t offset,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayDataStrided");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  if(stride == 0)
+    stride = mDataSize;
+  if(stride < mDataSize)
+    return LoggingImpl::reportError("The stride is smaller than the data size.", errorOut);
+  if(!node->evaluate(mDGNode, errorOut))
     return false;
 
-  uint32_t bufferSize = mDataSize * sliceCount;
-  void * buffer = malloc(bufferSize);
-
   try
   {
-    other->mDGNode.getMemberAllSlicesData(other->mMember.c_str(), bufferSize, buffer);
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    void * storage = NULL;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, count);
+    }
+    catch(FabricCore::Exception e)
+    {
+      storage = NULL;
+      count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if(count > 0)
+      {
+        storage = getScratchBuffer(count * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+      }
+    }
+
+    if(BulkIOImpl::getStridedSpan(count, mDataSize, stride, offset) > bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the array size.", errorOut);
+    if(count > 0)
+      BulkIOImpl::unpackStrided((char*)buffer + offset, storage, count, mDataSize, stride);
   }
   catch(FabricCore::Exception e)
   {
-    free(buffer);
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
+  return true;
+}
+
+bool DGPortImpl::setArrayDataStrided(
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t count,
+  uint32_t stride,
+  uint32_t offset,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayDataStrided");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && count != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  if(stride == 0)
+    stride = mDataSize;
+  if(stride < mDataSize)
+    return LoggingImpl::reportError("The stride is smaller than the data size.", errorOut);
+  if(BulkIOImpl::getStridedSpan(count, mDataSize, stride, offset) > bufferSize)
+    return LoggingImpl::reportError("Invalid buffer size.", errorOut);
+
   try
   {
-    mDGNode.setMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+    resizeArraySlice(slice, count);
+
+    if(count > 0)
+    {
+      // pack straight into the member storage, fall back to
+      // the scratch buffer if the storage can't be accessed
+      FabricCore::RTVal arrayVal;
+      uint32_t storageCount = 0;
+      void * storage = NULL;
+      try
+      {
+        storage = accessArrayStorage(arrayVal, slice, storageCount);
+      }
+      catch(FabricCore::Exception e)
+      {
+        storage = NULL;
+      }
+
+      if(storage != NULL && storageCount == count)
+      {
+        BulkIOImpl::packStrided(storage, (const char*)buffer + offset, count, mDataSize, stride);
+        commitArrayStorage(arrayVal, slice);
+      }
+      else
+      {
+        void * scratch = getScratchBuffer(count * mDataSize);
+        BulkIOImpl::packStrided(scratch, (const char*)buffer + offset, count, mDataSize, stride);
+        mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, scratch);
+      }
+    }
   }
   catch(FabricCore::Exception e)
   {
-    free(buffer);
     return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
   }
 
-  free(buffer);
-  DGGraphImplPtr node = getDGGraph();
-  if(!node)
-    return LoggingImpl::reportError("DGPortImpl::copyAllSlicesDataFromDGPort, Node '"+mGraphName+"' already destroyed.");
-  node->requireEvaluate();
+  node->requireEvaluate(mDGNodeName);
   return true;
 }
 
+bool DGPortImpl::getArrayField(
+  const char * field,
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayField");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t fieldOffset = 0;
+  uint32_t fieldSize = 0;
+  if(!getFieldLayout(field, fieldOffset, fieldSize, errorOut))
+    return false;
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    void * storage = NULL;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, count);
+    }
+    catch(FabricCore::Exception e)
+    {
+      storage = NULL;
+      count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if(count > 0)
+      {
+        storage = getScratchBuffer(count * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+      }
+    }
+
+    if((uint64_t)count * fieldSize != bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the array size.", errorOut);
+    if(count > 0)
+      BulkIOImpl::packStrided(buffer, (const char*)storage + fieldOffset, count, fieldSize, mDataSize);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setArrayField(
+  const char * field,
+  void * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayField");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t fieldOffset = 0;
+  uint32_t fieldSize = 0;
+  if(!getFieldLayout(field, fieldOffset, fieldSize, errorOut))
+    return false;
+
+  try
+  {
+    // the other fields are kept, so the field is written in place
+    // or through a full round trip via the scratch buffer
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    void * storage = NULL;
+    bool inPlace = true;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, count);
+    }
+    catch(FabricCore::Exception e)
+    {
+      inPlace = false;
+      storage = NULL;
+      count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+    }
+
+    if((uint64_t)count * fieldSize != bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the array size.", errorOut);
+    if(count == 0)
+      return true;
+
+    if(inPlace)
+    {
+      BulkIOImpl::unpackStrided((char*)storage + fieldOffset, buffer, count, fieldSize, mDataSize);
+      commitArrayStorage(arrayVal, slice);
+    }
+    else
+    {
+      storage = getScratchBuffer(count * mDataSize);
+      mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+      BulkIOImpl::unpackStrided((char*)storage + fieldOffset, buffer, count, fieldSize, mDataSize);
+      mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getAllSlicesData(void * buffer, uint32_t bufferSize, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getAllSlicesData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  uint32_t sliceCount = mDGNode.getSize();
+  if(sliceCount * mDataSize != bufferSize)
+    return LoggingImpl::reportError("Buffer size does not match slice count.", errorOut);
+
+  try
+  {
+    mDGNode.getMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setAllSlicesData(void * buffer, uint32_t bufferSize, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setAllSlicesData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+
+  uint32_t sliceCount = mDGNode.getSize();
+  uint32_t bufferCount = bufferSize / mDataSize;
+  if(bufferCount * mDataSize != bufferSize)
+    return LoggingImpl::reportError("Invalid buffer size.", errorOut);
+  if(bufferCount != sliceCount)
+    return LoggingImpl::reportError("The buffer size does not match the slice count.", errorOut);
+
+  try
+  {
+    mDGNode.setMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::checkSliceDataSize(uint32_t dataSize, std::string * errorOut)
+{
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(dataSize != mDataSize)
+    return LoggingImpl::reportError("DGPort '"+getName()+"': The buffer size does not match the data size of type '"+mDataType+"'.", errorOut);
+  return true;
+}
+
+bool DGPortImpl::getSliceData(void * buffer, uint32_t bufferSize, uint32_t slice, std::string * errorOut)
+{
+  // the traits were checked on construction, only mismatches need reporting
+  if(bufferSize == 0 || bufferSize != mSliceDataSize)
+    return checkSliceDataSize(bufferSize, errorOut);
+
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getSliceData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(buffer == NULL)
+    return LoggingImpl::reportError("No valid buffer provided.", errorOut);
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    uint32_t sliceCount = mDGNode.getSize();
+    if(slice >= sliceCount)
+      return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+    // single slice nodes are copied straight into the buffer. otherwise only the
+    // requested slice is read, through a single element array to reach its bytes
+    if(sliceCount == 1)
+      mDGNode.getMemberAllSlicesData(mMember.c_str(), mDataSize, buffer);
+    else
+    {
+      FabricCore::RTVal arrayVal = FabricCore::RTVal::ConstructVariableArray(*DGGraphImpl::getClient(), mDataType.c_str());
+      arrayVal.setArraySize(1);
+      arrayVal.setArrayElement(0, mDGNode.getMemberSliceValue(mMember.c_str(), slice));
+      memcpy(buffer, arrayVal.callMethod("Data", "data", 0, 0).getData(), mDataSize);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setSliceData(const void * buffer, uint32_t bufferSize, uint32_t slice, std::string * errorOut)
+{
+  // the traits were checked on construction, only mismatches need reporting
+  if(bufferSize == 0 || bufferSize != mSliceDataSize)
+    return checkSliceDataSize(bufferSize, errorOut);
+
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setSliceData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(buffer == NULL)
+    return LoggingImpl::reportError("No valid buffer provided.", errorOut);
+
+  try
+  {
+    uint32_t sliceCount = mDGNode.getSize();
+    if(slice >= sliceCount)
+      return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+    if(sliceCount == 1)
+      mDGNode.setMemberAllSlicesData(mMember.c_str(), mDataSize, buffer);
+    else
+    {
+      FabricCore::RTVal arrayVal = FabricCore::RTVal::ConstructVariableArray(*DGGraphImpl::getClient(), mDataType.c_str());
+      arrayVal.setArraySize(1);
+      memcpy(arrayVal.callMethod("Data", "data", 0, 0).getData(), buffer, mDataSize);
+      mDGNode.setMemberSliceValue(mMember.c_str(), slice, arrayVal.getArrayElement(0));
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getAllSlicesArrayData(
+  uint32_t * offsets,
+  uint32_t offsetsCount,
+  void * buffer,
+  uint32_t bufferSize,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getAllSlicesArrayData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(offsets == NULL)
+    return LoggingImpl::reportError("No valid offsets provided.", errorOut);
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    uint32_t sliceCount = mDGNode.getSize();
+    if(offsetsCount != sliceCount + 1)
+      return LoggingImpl::reportError("The offsets count does not match the slice count.", errorOut);
+
+    uint64_t total = 0;
+    offsets[0] = 0;
+    for(uint32_t i=0;i<sliceCount;i++)
+    {
+      total += mDGNode.getMemberSliceArraySize(mMember.c_str(), i);
+      if(total > UINT_MAX / mDataSize)
+        return LoggingImpl::reportError("The array data exceeds the maximum buffer size.", errorOut);
+      offsets[i+1] = (uint32_t)total;
+    }
+
+    if(buffer == NULL)
+      return true;
+    if(bufferSize != offsets[sliceCount] * mDataSize)
+      return LoggingImpl::reportError("The buffer size does not match the array sizes.", errorOut);
+
+    char * dst = (char*)buffer;
+    for(uint32_t i=0;i<sliceCount;i++)
+    {
+      uint32_t sliceSize = (offsets[i+1] - offsets[i]) * mDataSize;
+      if(sliceSize == 0)
+        continue;
+      mDGNode.getMemberSliceArrayData(mMember.c_str(), i, sliceSize, dst + (size_t)offsets[i] * mDataSize);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setAllSlicesArrayData(
+  const uint32_t * offsets,
+  uint32_t offsetsCount,
+  void * buffer,
+  uint32_t bufferSize,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setAllSlicesArrayData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(offsets == NULL || offsetsCount == 0)
+    return LoggingImpl::reportError("No valid offsets provided.", errorOut);
+  if(offsets[0] != 0)
+    return LoggingImpl::reportError("The first offset has to be 0.", errorOut);
+  for(uint32_t i=1;i<offsetsCount;i++)
+  {
+    if(offsets[i] < offsets[i-1])
+      return LoggingImpl::reportError("The offsets have to be ascending.", errorOut);
+  }
+  uint32_t sliceCount = offsetsCount - 1;
+  if(offsets[sliceCount] > UINT_MAX / mDataSize || bufferSize != offsets[sliceCount] * mDataSize)
+    return LoggingImpl::reportError("The buffer size does not match the offsets.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+
+  try
+  {
+    if(mDGNode.getSize() != sliceCount)
+      mDGNode.setSize(sliceCount);
+
+    const char * src = (const char*)buffer;
+    for(uint32_t i=0;i<sliceCount;i++)
+    {
+      uint32_t count = offsets[i+1] - offsets[i];
+      resizeArraySlice(i, count);
+      if(count == 0)
+        continue;
+      mDGNode.setMemberSliceArrayData(mMember.c_str(), i, count * mDataSize, (void*)(src + (size_t)offsets[i] * mDataSize));
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getStringData(
+  uint32_t * offsets,
+  uint32_t offsetsCount,
+  char * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getStringData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(mDataType != "String")
+    return LoggingImpl::reportError("DGPort '"+getName()+"': The data type is not String.", errorOut);
+  if(offsets == NULL)
+    return LoggingImpl::reportError("No valid offsets provided.", errorOut);
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    if(mIsArray)
+    {
+      if(slice >= mDGNode.getSize())
+        return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+      arrayVal = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+      count = arrayVal.getArraySize();
+    }
+    else
+      count = mDGNode.getSize();
+    if(offsetsCount != count + 1)
+      return LoggingImpl::reportError("The offsets count does not match the string count.", errorOut);
+
+    // each string is read through its own RTVal, no Variant is involved
+    uint64_t total = 0;
+    offsets[0] = 0;
+    for(uint32_t i=0;i<count;i++)
+    {
+      FabricCore::RTVal stringVal;
+      if(mIsArray)
+        stringVal = arrayVal.getArrayElementRef(i);
+      else
+        stringVal = mDGNode.getMemberSliceValue(mMember.c_str(), i);
+      uint32_t length = stringVal.getStringLength();
+      if(total + length > UINT_MAX)
+        return LoggingImpl::reportError("The string data exceeds the maximum buffer size.", errorOut);
+      if(buffer != NULL)
+      {
+        if(total + length > bufferSize)
+          return LoggingImpl::reportError("The buffer size does not match the string lengths.", errorOut);
+        if(length > 0)
+          memcpy(buffer + total, stringVal.getStringCString(), length);
+      }
+      total += length;
+      offsets[i+1] = (uint32_t)total;
+    }
+
+    if(buffer != NULL && total != bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the string lengths.", errorOut);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setStringData(
+  const uint32_t * offsets,
+  uint32_t offsetsCount,
+  const char * buffer,
+  uint32_t bufferSize,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setStringData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mDataType != "String")
+    return LoggingImpl::reportError("DGPort '"+getName()+"': The data type is not String.", errorOut);
+  if(offsets == NULL || offsetsCount == 0)
+    return LoggingImpl::reportError("No valid offsets provided.", errorOut);
+  if(offsets[0] != 0)
+    return LoggingImpl::reportError("The first offset has to be 0.", errorOut);
+  for(uint32_t i=1;i<offsetsCount;i++)
+  {
+    if(offsets[i] < offsets[i-1])
+      return LoggingImpl::reportError("The offsets have to be ascending.", errorOut);
+  }
+  uint32_t count = offsetsCount - 1;
+  if(bufferSize != offsets[count])
+    return LoggingImpl::reportError("The buffer size does not match the offsets.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  const char * src = buffer != NULL ? buffer : "";
+  try
+  {
+    if(mIsArray)
+    {
+      if(slice >= mDGNode.getSize())
+        return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+      resizeArraySlice(slice, count);
+      FabricCore::RTVal arrayVal = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+      for(uint32_t i=0;i<count;i++)
+        arrayVal.setArrayElement(i, FabricCore::RTVal::ConstructString(*client, src + offsets[i], offsets[i+1] - offsets[i]));
+      commitArrayStorage(arrayVal, slice);
+    }
+    else
+    {
+      if(mDGNode.getSize() != count)
+        mDGNode.setSize(count);
+      for(uint32_t i=0;i<count;i++)
+        mDGNode.setMemberSliceValue(mMember.c_str(), i, FabricCore::RTVal::ConstructString(*client, src + offsets[i], offsets[i+1] - offsets[i]));
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getArrayDataConverted(
+  void * buffer,
+  uint32_t bufferSize,
+  BulkIOImpl::DataFormat format,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayDataConverted");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t formatSize = BulkIOImpl::getDataFormatSize(format);
+  if(formatSize == 0)
+    return LoggingImpl::reportError("Unknown data format.", errorOut);
+  uint32_t scalarCount = 0;
+  if(!getFloat32ScalarCount(scalarCount, errorOut))
+    return false;
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    void * storage = NULL;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, count);
+    }
+    catch(FabricCore::Exception e)
+    {
+      storage = NULL;
+      count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if(count > 0)
+      {
+        storage = getScratchBuffer(count * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+      }
+    }
+
+    if((uint64_t)count * scalarCount * formatSize != bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the array size.", errorOut);
+    if(count > 0)
+      BulkIOImpl::convertFromFloat32(buffer, format, (const float*)storage, count * scalarCount);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setArrayDataConverted(
+  void * buffer,
+  uint32_t bufferSize,
+  BulkIOImpl::DataFormat format,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayDataConverted");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t formatSize = BulkIOImpl::getDataFormatSize(format);
+  if(formatSize == 0)
+    return LoggingImpl::reportError("Unknown data format.", errorOut);
+  uint32_t scalarCount = 0;
+  if(!getFloat32ScalarCount(scalarCount, errorOut))
+    return false;
+
+  uint32_t sourceElementSize = scalarCount * formatSize;
+  uint32_t count = bufferSize / sourceElementSize;
+  if(count * sourceElementSize != bufferSize)
+    return LoggingImpl::reportError("Invalid buffer size.", errorOut);
+  // narrower formats expand when converted to Float32
+  if((uint64_t)count * mDataSize > UINT_MAX)
+    return LoggingImpl::reportError("The converted array exceeds the maximum buffer size.", errorOut);
+
+  try
+  {
+    resizeArraySlice(slice, count);
+
+    if(count > 0)
+    {
+      // convert straight into the member storage, fall back to
+      // the scratch buffer if the storage can't be accessed
+      FabricCore::RTVal arrayVal;
+      uint32_t storageCount = 0;
+      void * storage = NULL;
+      try
+      {
+        storage = accessArrayStorage(arrayVal, slice, storageCount);
+      }
+      catch(FabricCore::Exception e)
+      {
+        storage = NULL;
+      }
+
+      if(storage != NULL && storageCount == count)
+      {
+        BulkIOImpl::convertToFloat32((float*)storage, buffer, format, count * scalarCount);
+        commitArrayStorage(arrayVal, slice);
+      }
+      else
+      {
+        void * scratch = getScratchBuffer(count * mDataSize);
+        BulkIOImpl::convertToFloat32((float*)scratch, buffer, format, count * scalarCount);
+        mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, scratch);
+      }
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getAllSlicesDataConverted(void * buffer, uint32_t bufferSize, BulkIOImpl::DataFormat format, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getAllSlicesDataConverted");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t formatSize = BulkIOImpl::getDataFormatSize(format);
+  if(formatSize == 0)
+    return LoggingImpl::reportError("Unknown data format.", errorOut);
+  uint32_t scalarCount = 0;
+  if(!getFloat32ScalarCount(scalarCount, errorOut))
+    return false;
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  uint32_t sliceCount = mDGNode.getSize();
+  if((uint64_t)sliceCount * scalarCount * formatSize != bufferSize)
+    return LoggingImpl::reportError("Buffer size does not match slice count.", errorOut);
+  if(sliceCount == 0)
+    return true;
+
+  try
+  {
+    void * scratch = getScratchBuffer(sliceCount * mDataSize);
+    mDGNode.getMemberAllSlicesData(mMember.c_str(), sliceCount * mDataSize, scratch);
+    BulkIOImpl::convertFromFloat32(buffer, format, (const float*)scratch, sliceCount * scalarCount);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setAllSlicesDataConverted(void * buffer, uint32_t bufferSize, BulkIOImpl::DataFormat format, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setAllSlicesDataConverted");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  uint32_t formatSize = BulkIOImpl::getDataFormatSize(format);
+  if(formatSize == 0)
+    return LoggingImpl::reportError("Unknown data format.", errorOut);
+  uint32_t scalarCount = 0;
+  if(!getFloat32ScalarCount(scalarCount, errorOut))
+    return false;
+
+  uint32_t sliceCount = mDGNode.getSize();
+  if((uint64_t)sliceCount * scalarCount * formatSize != bufferSize)
+    return LoggingImpl::reportError("The buffer size does not match the slice count.", errorOut);
+
+  if(sliceCount > 0)
+  {
+    try
+    {
+      void * scratch = getScratchBuffer(sliceCount * mDataSize);
+      BulkIOImpl::convertToFloat32((float*)scratch, buffer, format, sliceCount * scalarCount);
+      mDGNode.setMemberAllSlicesData(mMember.c_str(), sliceCount * mDataSize, scratch);
+    }
+    catch(FabricCore::Exception e)
+    {
+      return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+    }
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getArrayDataMatrices(
+  void * buffer,
+  uint32_t bufferSize,
+  BulkIOImpl::MatrixOrder order,
+  BulkIOImpl::DataFormat format,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getArrayDataMatrices");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  bool isXfo = false;
+  if(!getMatrixSource(false, order, format, isXfo, errorOut))
+    return false;
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  try
+  {
+    FabricCore::RTVal arrayVal;
+    uint32_t count = 0;
+    void * storage = NULL;
+    try
+    {
+      storage = accessArrayStorage(arrayVal, slice, count);
+    }
+    catch(FabricCore::Exception e)
+    {
+      storage = NULL;
+      count = mDGNode.getMemberSliceArraySize(mMember.c_str(), slice);
+      if((uint64_t)count * mDataSize > UINT_MAX)
+        return LoggingImpl::reportError("The array data exceeds the maximum buffer size.", errorOut);
+      if(count > 0)
+      {
+        storage = getScratchBuffer(count * mDataSize);
+        mDGNode.getMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, storage);
+      }
+    }
+
+    if((uint64_t)count * 16 * BulkIOImpl::getDataFormatSize(format) != bufferSize)
+      return LoggingImpl::reportError("The buffer size does not match the array size.", errorOut);
+    if(count > 0)
+      convertToMatrices(buffer, order, format, isXfo, storage, count);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setArrayDataMatrices(
+  void * buffer,
+  uint32_t bufferSize,
+  BulkIOImpl::MatrixOrder order,
+  BulkIOImpl::DataFormat format,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setArrayDataMatrices");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  bool isXfo = false;
+  if(!getMatrixSource(true, order, format, isXfo, errorOut))
+    return false;
+
+  uint32_t sourceElementSize = 16 * BulkIOImpl::getDataFormatSize(format);
+  uint32_t count = bufferSize / sourceElementSize;
+  if((uint64_t)count * sourceElementSize != bufferSize)
+    return LoggingImpl::reportError("Invalid buffer size.", errorOut);
+  // narrower formats expand when converted to Mat44
+  if((uint64_t)count * mDataSize > UINT_MAX)
+    return LoggingImpl::reportError("The converted array exceeds the maximum buffer size.", errorOut);
+
+  try
+  {
+    resizeArraySlice(slice, count);
+
+    if(count > 0)
+    {
+      // convert straight into the member storage, fall back to
+      // the scratch buffer if the storage can't be accessed
+      FabricCore::RTVal arrayVal;
+      uint32_t storageCount = 0;
+      void * storage = NULL;
+      try
+      {
+        storage = accessArrayStorage(arrayVal, slice, storageCount);
+      }
+      catch(FabricCore::Exception e)
+      {
+        storage = NULL;
+      }
+
+      if(storage != NULL && storageCount == count)
+      {
+        BulkIOImpl::convertToMat44((float*)storage, buffer, format, order, count);
+        commitArrayStorage(arrayVal, slice);
+      }
+      else
+      {
+        void * scratch = getScratchBuffer(count * mDataSize);
+        BulkIOImpl::convertToMat44((float*)scratch, buffer, format, order, count);
+        mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, count * mDataSize, scratch);
+      }
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getAllSlicesDataMatrices(void * buffer, uint32_t bufferSize, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getAllSlicesDataMatrices");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  bool isXfo = false;
+  if(!getMatrixSource(false, order, format, isXfo, errorOut))
+    return false;
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  uint32_t sliceCount = mDGNode.getSize();
+  if((uint64_t)sliceCount * 16 * BulkIOImpl::getDataFormatSize(format) != bufferSize)
+    return LoggingImpl::reportError("Buffer size does not match slice count.", errorOut);
+  if(sliceCount == 0)
+    return true;
+  if((uint64_t)sliceCount * mDataSize > UINT_MAX)
+    return LoggingImpl::reportError("The slice data exceeds the maximum buffer size.", errorOut);
+
+  try
+  {
+    void * scratch = getScratchBuffer(sliceCount * mDataSize);
+    mDGNode.getMemberAllSlicesData(mMember.c_str(), sliceCount * mDataSize, scratch);
+    convertToMatrices(buffer, order, format, isXfo, scratch, sliceCount);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return true;
+}
+
+bool DGPortImpl::setAllSlicesDataMatrices(void * buffer, uint32_t bufferSize, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setAllSlicesDataMatrices");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(buffer == NULL && bufferSize != 0)
+    return LoggingImpl::reportError("No valid buffer / bufferSize provided.", errorOut);
+  bool isXfo = false;
+  if(!getMatrixSource(true, order, format, isXfo, errorOut))
+    return false;
+
+  uint32_t sliceCount = mDGNode.getSize();
+  if((uint64_t)sliceCount * 16 * BulkIOImpl::getDataFormatSize(format) != bufferSize)
+    return LoggingImpl::reportError("The buffer size does not match the slice count.", errorOut);
+  if((uint64_t)sliceCount * mDataSize > UINT_MAX)
+    return LoggingImpl::reportError("The slice data exceeds the maximum buffer size.", errorOut);
+
+  if(sliceCount > 0)
+  {
+    try
+    {
+      void * scratch = getScratchBuffer(sliceCount * mDataSize);
+      BulkIOImpl::convertToMat44((float*)scratch, buffer, format, order, sliceCount);
+      mDGNode.setMemberAllSlicesData(mMember.c_str(), sliceCount * mDataSize, scratch);
+    }
+    catch(FabricCore::Exception e)
+    {
+      return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+    }
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::copyArrayDataFromDGPort(DGPortImplPtr other, uint32_t slice, uint32_t otherSliceHint, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::copyArrayDataFromDGPort");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(!other)
+    return LoggingImpl::reportError("Other DGPort is not valid.", errorOut);
+  if(other->mMode == Mode_IN)
+    return LoggingImpl::reportError("Other DGPort is not an out DGPort.", errorOut);
+  if(!other->mIsShallow)
+    return LoggingImpl::reportError("Other DGPort is not shallow.", errorOut);
+  if(!other->mIsArray)
+    return LoggingImpl::reportError("Other DGPort is not an array.", errorOut);
+  if(other->mDataType != mDataType)
+    return LoggingImpl::reportError("DGPorts' data types don't match.", errorOut);
+  if(other->mDataSize != mDataSize)
+    return LoggingImpl::reportError("DGPorts' data sizes don't match.", errorOut);
+  if(slice > getSliceCount())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+  GraphRef otherNode = other->resolveDGGraph();
+  if(!otherNode)
+    return other->reportGraphDestroyed("DGPortImpl::copyArrayDataFromDGPort");
+  if(!otherNode->evaluate(other->mDGNode, errorOut))
+    return false;
+
+  uint32_t otherSlice = otherSliceHint;
+  if(otherSlice == UINT_MAX)
+    otherSlice = slice;
+  if(otherSlice > other->getSliceCount())
+    return LoggingImpl::reportError("Other DGPort's slice out of bounds.", errorOut);
+
+  if(!copyArraySliceFromDGPort(other, slice, otherSlice, errorOut))
+    return false;
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::copyAllSlicesDataFromDGPort(DGPortImplPtr other, bool resizeTarget, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::copyAllSlicesDataFromDGPort");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(mIsArray)
+    return LoggingImpl::reportError("DGPort is an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(!other)
+    return LoggingImpl::reportError("Other DGPort is not valid.", errorOut);
+  if(other->mMode == Mode_IN)
+    return LoggingImpl::reportError("Other DGPort is not an out DGPort.", errorOut);
+  if(!other->mIsShallow)
+    return LoggingImpl::reportError("Other DGPort is not shallow.", errorOut);
+  if(other->mIsArray)
+    return LoggingImpl::reportError("Other DGPort is an array.", errorOut);
+  if(other->mDataType != mDataType)
+    return LoggingImpl::reportError("DGPorts' data types don't match.", errorOut);
+  if(other->mDataSize != mDataSize)
+    return LoggingImpl::reportError("DGPorts' data sizes don't match.", errorOut);
+
+  GraphRef otherNode = other->resolveDGGraph();
+  if(!otherNode)
+    return other->reportGraphDestroyed("DGPortImpl::copyAllSlicesDataFromDGPort");
+  if(!otherNode->evaluate(other->mDGNode, errorOut))
+    return false;
+
+  uint32_t sliceCount = other->mDGNode.getSize();
+  if(sliceCount != mDGNode.getSize())
+  {
+    if(resizeTarget)
+      mDGNode.setSize(sliceCount);
+    else
+      return LoggingImpl::reportError("Slice counts don't match.", errorOut);
+  }
+
+  if(sliceCount == 0)
+    return true;
+
+  // slices don't expose a contiguous storage, so go through the scratch buffer
+  uint32_t bufferSize = mDataSize * sliceCount;
+  void * buffer = getScratchBuffer(bufferSize);
+
+  try
+  {
+    other->mDGNode.getMemberAllSlicesData(other->mMember.c_str(), bufferSize, buffer);
+    mDGNode.setMemberAllSlicesData(mMember.c_str(), bufferSize, buffer);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::copyAllSlicesArrayDataFromDGPort(DGPortImplPtr other, bool resizeTarget, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::copyAllSlicesArrayDataFromDGPort");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(!other)
+    return LoggingImpl::reportError("Other DGPort is not valid.", errorOut);
+  if(other->mMode == Mode_IN)
+    return LoggingImpl::reportError("Other DGPort is not an out DGPort.", errorOut);
+  if(!other->mIsShallow)
+    return LoggingImpl::reportError("Other DGPort is not shallow.", errorOut);
+  if(!other->mIsArray)
+    return LoggingImpl::reportError("Other DGPort is not an array.", errorOut);
+  if(other->mDataType != mDataType)
+    return LoggingImpl::reportError("DGPorts' data types don't match.", errorOut);
+  if(other->mDataSize != mDataSize)
+    return LoggingImpl::reportError("DGPorts' data sizes don't match.", errorOut);
+
+  GraphRef otherNode = other->resolveDGGraph();
+  if(!otherNode)
+    return other->reportGraphDestroyed("DGPortImpl::copyAllSlicesArrayDataFromDGPort");
+  if(!otherNode->evaluate(other->mDGNode, errorOut))
+    return false;
+
+  uint32_t sliceCount = other->mDGNode.getSize();
+  if(sliceCount != mDGNode.getSize())
+  {
+    if(resizeTarget)
+      mDGNode.setSize(sliceCount);
+    else
+      return LoggingImpl::reportError("Slice counts don't match.", errorOut);
+  }
+
+  for(uint32_t slice=0;slice<sliceCount;slice++)
+  {
+    if(!copyArraySliceFromDGPort(other, slice, slice, errorOut))
+      return false;
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::copyArraySliceFromDGPort(DGPortImplPtr other, uint32_t slice, uint32_t otherSlice, std::string * errorOut)
+{
+  ScratchBufferScope scratchScope;
+  if(other.get() == this && otherSlice == slice)
+    return true;
+
+  // FabricCore doesn't expose the source storage, so the array is copied
+  // out into the scratch buffer and from there into the target member
+  try
+  {
+    uint32_t arrayCount = other->mDGNode.getMemberSliceArraySize(other->mMember.c_str(), otherSlice);
+    uint32_t bufferSize = mDataSize * arrayCount;
+    void * buffer = NULL;
+    if(bufferSize > 0)
+    {
+      buffer = getScratchBuffer(bufferSize);
+      other->mDGNode.getMemberSliceArrayData(other->mMember.c_str(), otherSlice, bufferSize, buffer);
+    }
+
+    resizeArraySlice(slice, arrayCount);
+    if(bufferSize > 0)
+      mDGNode.setMemberSliceArrayData(mMember.c_str(), slice, bufferSize, buffer);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+void * DGPortImpl::getScratchBuffer(uint32_t size)
+{
+  std::vector<char> * buffer = sScratchBuffer.get();
+  if(buffer == NULL)
+  {
+    buffer = new std::vector<char>();
+    sScratchBuffer.reset(buffer);
+  }
+  if(buffer->size() < size)
+    buffer->resize(size);
+  if(buffer->size() == 0)
+    return NULL;
+  return &(*buffer)[0];
+}
+
+void * DGPortImpl::acquireArrayDataCopy(
+  uint32_t & count,
+  bool writable,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph(writable);
+  if(!node)
+  {
+    reportGraphDestroyed("DGPortImpl::acquireArrayDataCopy");
+    return NULL;
+  }
+  count = 0;
+  if(mHasArrayCopy)
+  {
+    LoggingImpl::reportError("DGPort already holds a copy of its array data.", errorOut);
+    return NULL;
+  }
+  if(writable && mMode == Mode_OUT)
+  {
+    LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+    return NULL;
+  }
+  if(!writable && mMode == Mode_IN)
+  {
+    LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+    return NULL;
+  }
+  if(!mIsArray)
+  {
+    LoggingImpl::reportError("DGPort is not an array.", errorOut);
+    return NULL;
+  }
+  if(!mIsShallow)
+  {
+    LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+    return NULL;
+  }
+  if(slice >= mDGNode.getSize())
+  {
+    LoggingImpl::reportError("Slice out of bounds.", errorOut);
+    return NULL;
+  }
+
+  // writable copies on IO ports can be used for read-modify-write,
+  // so make sure the data is up to date in both cases
+  if(mMode != Mode_IN)
+    if(!node->evaluate(mDGNode, errorOut))
+      return NULL;
+
+  try
+  {
+    mArrayCopyData = accessArrayStorage(mArrayCopy, slice, mArrayCopyCount);
+  }
+  catch(FabricCore::Exception e)
+  {
+    mArrayCopy.invalidate();
+    mArrayCopyData = NULL;
+    mArrayCopyCount = 0;
+    LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+    return NULL;
+  }
+
+  mHasArrayCopy = true;
+  mArrayCopySlice = slice;
+  mArrayCopyWritable = writable;
+  count = mArrayCopyCount;
+  return mArrayCopyData;
+}
+
+bool DGPortImpl::releaseArrayDataCopy(std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(mArrayCopyWritable);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::releaseArrayDataCopy");
+  if(!mHasArrayCopy)
+    return LoggingImpl::reportError("DGPort holds no copy of its array data.", errorOut);
+
+  FabricCore::RTVal arrayVal = mArrayCopy;
+  bool writable = mArrayCopyWritable;
+  uint32_t slice = mArrayCopySlice;
+
+  mHasArrayCopy = false;
+  mArrayCopy.invalidate();
+  mArrayCopyData = NULL;
+  mArrayCopyCount = 0;
+  mArrayCopyWritable = false;
+
+  if(!writable)
+    return true;
+
+  try
+  {
+    commitArrayStorage(arrayVal, slice);
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+TypeLayoutImplPtr DGPortImpl::getTypeLayout(std::string * errorOut)
+{
+  // the KL code might have changed since the layout was determined
+  uint32_t generation = TypeLayoutImpl::getCacheGeneration();
+  if(mTypeLayout && mTypeLayoutGeneration != generation)
+  {
+    mTypeLayout.reset();
+    mJSONCodecSupport = -1;
+  }
+  if(!mTypeLayout)
+  {
+    mTypeLayout = TypeLayoutImpl::getLayout(mDataType, errorOut);
+    mTypeLayoutGeneration = generation;
+  }
+  return mTypeLayout;
+}
+
+bool DGPortImpl::getFieldLayout(const char * field, uint32_t & offset, uint32_t & size, std::string * errorOut)
+{
+  std::string path = field ? field : "";
+  TypeLayoutImplPtr layout = getTypeLayout(errorOut);
+  if(!layout)
+    return false;
+  if(!layout->getField(path, offset, size))
+    return LoggingImpl::reportError("DGPort '"+getName()+"': Type '"+mDataType+"' has no field '"+path+"'.", errorOut);
+  return true;
+}
+
+bool DGPortImpl::bindExternalArrayData(
+  void * data,
+  uint32_t count,
+  ExternalArrayReleaseFunc releaseFunc,
+  void * userData,
+  uint32_t slice,
+  std::string * errorOut
+  )
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::bindExternalArrayData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!mIsArray)
+    return LoggingImpl::reportError("DGPort is not an array.", errorOut);
+  if(!mIsShallow)
+    return LoggingImpl::reportError("DGPort is not shallow.", errorOut);
+  if(slice >= mDGNode.getSize())
+    return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+  if(data == NULL && count != 0)
+    return LoggingImpl::reportError("No valid data provided.", errorOut);
+  if(count > UINT_MAX / mDataSize)
+    return LoggingImpl::reportError("The external array data exceeds the maximum buffer size.", errorOut);
+
+  ExternalArrayMap::iterator it = mExternalArrays.find(slice);
+  if(it != mExternalArrays.end())
+  {
+    // the previous buffer is only released if the host actually swapped it
+    ExternalArray & prev = it->second;
+    if(prev.releaseFunc && (prev.data != data || prev.releaseFunc != releaseFunc || prev.userData != userData))
+      (*prev.releaseFunc)(prev.data, prev.userData);
+  }
+
+  ExternalArray & binding = mExternalArrays[slice];
+  binding.data = data;
+  binding.count = count;
+  binding.releaseFunc = releaseFunc;
+  binding.userData = userData;
+  binding.requiresSync = true;
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::invalidateExternalArrayData(uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::invalidateExternalArrayData");
+  ExternalArrayMap::iterator it = mExternalArrays.find(slice);
+  if(it == mExternalArrays.end())
+    return LoggingImpl::reportError("DGPort '"+getName()+"' has no external array data bound to the slice.", errorOut);
+
+  it->second.requiresSync = true;
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::unbindExternalArrayData(uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::unbindExternalArrayData");
+  ExternalArrayMap::iterator it = mExternalArrays.find(slice);
+  if(it == mExternalArrays.end())
+    return LoggingImpl::reportError("DGPort '"+getName()+"' has no external array data bound to the slice.", errorOut);
+
+  // pending changes still have to reach the member before the buffer goes away
+  bool result = true;
+  if(it->second.requiresSync)
+    result = syncExternalArrayData(errorOut);
+
+  it = mExternalArrays.find(slice);
+  if(it != mExternalArrays.end())
+  {
+    ExternalArray binding = it->second;
+    mExternalArrays.erase(it);
+    if(binding.releaseFunc)
+      (*binding.releaseFunc)(binding.data, binding.userData);
+  }
+  return result;
+}
+
+bool DGPortImpl::isExternalArrayDataBound(uint32_t slice) const
+{
+  return mExternalArrays.find(slice) != mExternalArrays.end();
+}
+
+bool DGPortImpl::syncExternalArrayData(std::string * errorOut)
+{
+  try
+  {
+    uint32_t sliceCount = mDGNode.getSize();
+    for(ExternalArrayMap::iterator it = mExternalArrays.begin(); it != mExternalArrays.end(); it++)
+    {
+      ExternalArray & binding = it->second;
+      if(!binding.requiresSync)
+        continue;
+      if(it->first >= sliceCount)
+        return LoggingImpl::reportError("DGPort '"+getName()+"': The slice of the external array data is out of bounds.", errorOut);
+
+      // the host buffer is read straight into the member, without any staging copy
+      resizeArraySlice(it->first, binding.count);
+      if(binding.count > 0)
+        mDGNode.setMemberSliceArrayData(mMember.c_str(), it->first, binding.count * mDataSize, binding.data);
+      binding.requiresSync = false;
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+  return true;
+}
+
+TypeLayoutImplPtr DGPortImpl::getJSONLayout()
+{
+  if(mJSONCodecSupport >= 0 && mTypeLayoutGeneration != TypeLayoutImpl::getCacheGeneration())
+    mJSONCodecSupport = -1;
+  if(mJSONCodecSupport < 0)
+  {
+    mJSONCodecSupport = 0;
+    if(mIsShallow && !isObject() && !isInterface())
+    {
+      std::string layoutError;
+      TypeLayoutImplPtr layout = getTypeLayout(&layoutError);
+      if(!layout)
+      {
+        // types without a known layout keep using the Variant based JSON IO
+        LoggingImpl::clearError();
+      }
+      else if(layout->getSize() == mDataSize)
+        mJSONCodecSupport = 1;
+    }
+  }
+  if(mJSONCodecSupport == 0)
+    return TypeLayoutImplPtr();
+  return mTypeLayout;
+}
+
+bool DGPortImpl::getFloat32ScalarCount(uint32_t & scalarCount, std::string * errorOut)
+{
+  TypeLayoutImplPtr layout = getTypeLayout(errorOut);
+  if(!layout)
+    return false;
+  if(!layout->isHomogeneous(TypeLayoutImpl::LeafType_Float32) || layout->getSize() != mDataSize)
+    return LoggingImpl::reportError("DGPort's data type '"+mDataType+"' does not consist of Float32 only.", errorOut);
+  scalarCount = layout->getLeafCount();
+  return true;
+}
+
+bool DGPortImpl::getMatrixSource(bool writing, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, bool & isXfo, std::string * errorOut)
+{
+  if(BulkIOImpl::getDataFormatSize(format) == 0)
+    return LoggingImpl::reportError("Unknown data format.", errorOut);
+  if(order != BulkIOImpl::MatrixOrder_RowMajor && order != BulkIOImpl::MatrixOrder_ColumnMajor)
+    return LoggingImpl::reportError("Unknown matrix order.", errorOut);
+  isXfo = mDataType == "Xfo";
+  if(mDataType == "Mat44" || (isXfo && !writing))
+    return true;
+  if(writing)
+    return LoggingImpl::reportError("DGPort '"+getName()+"': Matrices can only be set on Mat44 DGPorts.", errorOut);
+  return LoggingImpl::reportError("DGPort '"+getName()+"': Matrices can only be read from Mat44 or Xfo DGPorts.", errorOut);
+}
+
+void DGPortImpl::convertToMatrices(void * buffer, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, bool isXfo, const void * storage, uint32_t count)
+{
+  if(isXfo)
+    BulkIOImpl::convertFromXfo(buffer, format, order, (const float*)storage, count);
+  else
+    BulkIOImpl::convertFromMat44(buffer, format, order, (const float*)storage, count);
+}
+
+void * DGPortImpl::accessArrayStorage(FabricCore::RTVal & arrayVal, uint32_t slice, uint32_t & count)
+{
+  // FabricCore doesn't expose the member storage itself, the RTVal holds a
+  // copy of the slice's array. the Data pointer refers to that copy, so
+  // changes only reach the member through commitArrayStorage.
+  arrayVal = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+  count = arrayVal.getArraySize();
+  if(count == 0)
+    return NULL;
+  FabricCore::RTVal dataVal = arrayVal.callMethod("Data", "data", 0, 0);
+  return dataVal.getData();
+}
+
+void DGPortImpl::commitArrayStorage(FabricCore::RTVal & arrayVal, uint32_t slice)
+{
+  // this copies the whole array back into the member
+
+  mDGNode.setMemberSliceValue(mMember.c_str(), slice, arrayVal);
+}
+
+FabricCore::Variant DGPortImpl::getColumnSchema(std::string * errorOut)
+{
+  if(!isStruct() && !isObject())
+  {
+    LoggingImpl::reportError("DGPort '"+getName()+"': Columns are only supported for struct and object DGPorts.", errorOut);
+    return FabricCore::Variant();
+  }
+  ColumnLayoutImplPtr layout = ColumnLayoutImpl::getLayout(mDataType, errorOut);
+  if(!layout)
+    return FabricCore::Variant();
+  return layout->getSchema();
+}
+
+bool DGPortImpl::getColumnData(ColumnData * columns, uint32_t columnCount, uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph();
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::getColumnData");
+  if(mMode == Mode_IN)
+    return LoggingImpl::reportError("Cannot get data on an input DGPort.", errorOut);
+  if(!isStruct() && !isObject())
+    return LoggingImpl::reportError("DGPort '"+getName()+"': Columns are only supported for struct and object DGPorts.", errorOut);
+  ColumnLayoutImplPtr layout = ColumnLayoutImpl::getLayout(mDataType, errorOut);
+  if(!layout)
+    return false;
+
+  std::vector<ColumnLayoutImpl::Buffer> storage;
+  std::vector<ColumnLayoutImpl::Buffer*> buffers;
+  if(!getColumnBuffers(layout, columns, columnCount, storage, buffers, errorOut))
+    return false;
+
+  if(!node->evaluate(mDGNode, errorOut))
+    return false;
+
+  std::vector<FabricCore::RTVal> elements;
+  try
+  {
+    if(mIsArray)
+    {
+      if(slice >= mDGNode.getSize())
+        return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+      FabricCore::RTVal arrayVal = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+      elements.resize(arrayVal.getArraySize());
+      for(size_t i=0;i<elements.size();i++)
+        elements[i] = arrayVal.getArrayElementRef((uint32_t)i);
+    }
+    else
+    {
+      elements.resize(mDGNode.getSize());
+      for(size_t i=0;i<elements.size();i++)
+        elements[i] = mDGNode.getMemberSliceValue(mMember.c_str(), (uint32_t)i);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  return layout->read(elements, buffers, errorOut);
+}
+
+bool DGPortImpl::setColumnData(const ColumnData * columns, uint32_t columnCount, uint32_t count, uint32_t slice, std::string * errorOut)
+{
+  GraphRef node = resolveDGGraph(true);
+  if(!node)
+    return reportGraphDestroyed("DGPortImpl::setColumnData");
+  if(mMode == Mode_OUT)
+    return LoggingImpl::reportError("Cannot set data on an output DGPort.", errorOut);
+  if(!isStruct() && !isObject())
+    return LoggingImpl::reportError("DGPort '"+getName()+"': Columns are only supported for struct and object DGPorts.", errorOut);
+  ColumnLayoutImplPtr layout = ColumnLayoutImpl::getLayout(mDataType, errorOut);
+  if(!layout)
+    return false;
+
+  std::vector<ColumnLayoutImpl::Buffer> storage;
+  std::vector<ColumnLayoutImpl::Buffer*> buffers;
+  if(!getColumnBuffers(layout, columns, columnCount, storage, buffers, errorOut))
+    return false;
+
+  // all columns are checked before the member is resized
+  if(!layout->validate(count, buffers, true, errorOut))
+    return false;
+
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  std::vector<FabricCore::RTVal> elements(count);
+  try
+  {
+    if(mIsArray)
+    {
+      if(slice >= mDGNode.getSize())
+        return LoggingImpl::reportError("Slice out of bounds.", errorOut);
+
+      // the existing elements are kept for the columns which aren't provided
+      resizeArraySlice(slice, count);
+      FabricCore::RTVal arrayVal = mDGNode.getMemberSliceValue(mMember.c_str(), slice);
+      for(uint32_t i=0;i<count;i++)
+      {
+        elements[i] = arrayVal.getArrayElementRef(i);
+        if(isObject() && elements[i].isNullObject())
+        {
+          elements[i] = FabricCore::RTVal::Create(*client, mDataType.c_str(), 0, 0);
+          arrayVal.setArrayElement(i, elements[i]);
+        }
+      }
+      if(!layout->write(elements, buffers, errorOut))
+        return false;
+      commitArrayStorage(arrayVal, slice);
+    }
+    else
+    {
+      if(mDGNode.getSize() != count)
+        mDGNode.setSize(count);
+      for(uint32_t i=0;i<count;i++)
+      {
+        elements[i] = mDGNode.getMemberSliceValue(mMember.c_str(), i);
+        if(isObject() && elements[i].isNullObject())
+          elements[i] = FabricCore::RTVal::Create(*client, mDataType.c_str(), 0, 0);
+      }
+      if(!layout->write(elements, buffers, errorOut))
+        return false;
+      for(uint32_t i=0;i<count;i++)
+        mDGNode.setMemberSliceValue(mMember.c_str(), i, elements[i]);
+    }
+  }
+  catch(FabricCore::Exception e)
+  {
+    return LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+  }
+
+  node->requireEvaluate(mDGNodeName);
+  return true;
+}
+
+bool DGPortImpl::getColumnBuffers(
+  ColumnLayoutImplPtr layout,
+  const ColumnData * columns,
+  uint32_t columnCount,
+  std::vector<ColumnLayoutImpl::Buffer> & storage,
+  std::vector<ColumnLayoutImpl::Buffer*> & buffers,
+  std::string * errorOut
+  )
+{
+  if(columns == NULL && columnCount > 0)
+    return LoggingImpl::reportError("No valid columns provided.", errorOut);
+
+  storage.resize(columnCount);
+  buffers.resize(layout->getColumnCount(), NULL);
+  for(uint32_t i=0;i<columnCount;i++)
+  {
+    std::string path = columns[i].path ? columns[i].path : "";
+    int index = layout->getColumnIndex(path);
+    if(index < 0)
+      return LoggingImpl::reportError("DGPort '"+getName()+"': Unknown column '"+path+"'.", errorOut);
+    if(buffers[index] != NULL)
+      return LoggingImpl::reportError("DGPort '"+getName()+"': Column '"+path+"' is provided more than once.", errorOut);
+
+    storage[i].data = columns[i].data;
+    storage[i].dataSize = columns[i].dataSize;
+    storage[i].offsets = columns[i].offsets;
+    storage[i].offsetsCount = columns[i].offsetsCount;
+    buffers[index] = &storage[i];
+  }
+  return true;
+}
+
+void DGPortImpl::resizeArraySlice(uint32_t slice, uint32_t count)
+{
+  if(mDGNode.getMemberSliceArraySize(mMember.c_str(), slice) != count)
+    mDGNode.setMemberSliceArraySize(mMember.c_str(), slice, count);
+}
+
 void DGPortImpl::setOption(const std::string & name, const FabricCore::Variant & value)
 {
   std::map<std::string,FabricCore::Variant>::iterator it = mOptions.find(name);
@@ -6,6 +6,8 @@
 #include "LoggingImpl.h"
 #include "ObjectImpl.h"
 #include "TypeDefs.h"
+#include "BulkIOImpl.h"
+#include "ColumnLayoutImpl.h"
 #include <FabricCore.h>
 
 #include <limits.h>
@@ -15,6 +17,7 @@ namespace FabricSpliceImpl
   class DGPortImpl : public ObjectImpl
   {
     friend class DGGraphImpl;
+    friend class DGPortIOPlanImpl;
     
   public:
 
@@ -31,6 +34,18 @@ namespace FabricSpliceImpl
       Mode_IO
     };
 
+    /// the host buffers of a single column for the columnar IO.
+    /// variable columns (Strings and arrays) use offsetsCount = element count + 1
+    /// offsets into data, counted in column elements (bytes for Strings).
+    struct ColumnData
+    {
+      const char * path;
+      void * data;
+      uint32_t dataSize;
+      uint32_t * offsets;
+      uint32_t offsetsCount;
+    };
+
     /*
       Constructors / Destructors
     */
@@ -74,13 +89,13 @@ namespace FabricSpliceImpl
     bool isArray() const { return mIsArray; }
 
     /// returns true if the data type of this DGPort is a struct
-    bool isStruct() const { return mIsStruct; }
+    bool isStruct() const { resolveTypeTraits(); return mIsStruct; }
 
     /// returns true if the data type of this DGPort is an object
-    bool isObject() const { return mIsObject; }
+    bool isObject() const { resolveTypeTraits(); return mIsObject; }
 
     /// returns true if the data type of this DGPort is an interface
-    bool isInterface() const { return mIsInterface; }
+    bool isInterface() const { resolveTypeTraits(); return mIsInterface; }
 
     /// returns true if this port auto initializes KL objects
     bool doesAutoInitObjects() const { return mAutoInitObjects; }
@@ -105,6 +120,21 @@ namespace FabricSpliceImpl
     /// sets the value of a specific slice of this DGPort from a FabricCore::Variant
     bool setVariant(FabricCore::Variant value, uint32_t slice = 0, std::string * errorOut = NULL);
 
+    /// sets the given keys of a struct or KL Dict value of a specific slice from
+    /// a FabricCore::Variant dictionary. keys which aren't part of values are left
+    /// untouched, the graph is never evaluated.
+    bool setDictValues(const FabricCore::Variant & values, uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// removes a key from a KL Dict value of a specific slice
+    bool removeDictValue(const std::string & key, uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// returns the values of count slices starting at start as a FabricCore::Variant array
+    FabricCore::Variant getVariants(uint32_t start, uint32_t count, std::string * errorOut = NULL);
+
+    /// sets all slices of this DGPort from a FabricCore::Variant array,
+    /// resizing the FabricCore::DGNode to the size of the array.
+    bool setAllSlicesFromVariantArray(const FabricCore::Variant & values, std::string * errorOut = NULL);
+
     /// returns the value of a specific slice of this DGPort as a JSON string
     std::string getJSON(uint32_t slice = 0, std::string * errorOut = NULL);
 
@@ -125,6 +155,16 @@ namespace FabricSpliceImpl
         std::string * errorOut = NULL
         );
 
+    /// returns the values of count slices starting at start as FabricCore::RTVals
+    /// the results pointer has to provide room for count RTVals
+    bool getRTVals(
+        FabricCore::RTVal * results,
+        uint32_t start,
+        uint32_t count,
+        bool evaluate = false,
+        std::string * errorOut = NULL
+        );
+
     /// sets the value of a specific slice of this DGPort from a FabricCore::RTVal
     bool setRTVal(
         FabricCore::RTVal value,
@@ -161,6 +201,107 @@ namespace FabricSpliceImpl
         std::string * errorOut = NULL
         );
 
+    /// returns count elements of the array data of this DGPort starting at offset.
+    /// this only works for array DGPorts (isArray() == true)
+    /// the buffer has to hold count * getDataSize() bytes
+    bool getArrayDataRange(
+        void * buffer,
+        uint32_t offset,
+        uint32_t count,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets count elements of the array data of this DGPort starting at offset.
+    /// this only works for array DGPorts (isArray() == true)
+    /// the array is not resized, offset + count has to be within getArrayCount().
+    /// FabricCore only writes whole arrays, so this still copies the entire array.
+    bool setArrayDataRange(
+        void * buffer,
+        uint32_t offset,
+        uint32_t count,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// returns the array elements at the given indices into a tightly packed buffer.
+    /// this only works for array DGPorts (isArray() == true)
+    /// the buffer has to hold indexCount * getDataSize() bytes
+    bool gatherArrayData(
+        const uint32_t * indices,
+        uint32_t indexCount,
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the array elements at the given indices from a tightly packed buffer.
+    /// this only works for array DGPorts (isArray() == true)
+    /// the array is not resized, for duplicate indices the last element wins.
+    /// FabricCore only writes whole arrays, so this still copies the entire array.
+    bool scatterArrayData(
+        const uint32_t * indices,
+        uint32_t indexCount,
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// returns the array data of this DGPort into a strided buffer.
+    /// element i is written to buffer + offset + i * stride, the bytes in between
+    /// are left untouched. a stride of 0 means tightly packed (getDataSize()).
+    /// this only works for array DGPorts (isArray() == true)
+    /// the bufferSize has to cover getArrayCount() strided elements
+    bool getArrayDataStrided(
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t stride,
+        uint32_t offset = 0,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the array data of this DGPort from a strided buffer.
+    /// element i is read from buffer + offset + i * stride.
+    /// a stride of 0 means tightly packed (getDataSize()).
+    /// this only works for array DGPorts (isArray() == true)
+    /// this also sets the array count to count.
+    bool setArrayDataStrided(
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t count,
+        uint32_t stride,
+        uint32_t offset = 0,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// returns a single field of all array elements as a tightly packed buffer,
+    /// f.e. only "tr" of an Xfo[] DGPort. nested fields are separated by a dot.
+    /// this only works for shallow array DGPorts (isArray() == true)
+    /// the bufferSize has to match getArrayCount() * the byte size of the field
+    bool getArrayField(
+        const char * field,
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets a single field of all array elements from a tightly packed buffer,
+    /// the other fields keep their values.
+    /// this only works for shallow array DGPorts (isArray() == true)
+    /// the bufferSize has to match getArrayCount() * the byte size of the field
+    bool setArrayField(
+        const char * field,
+        void * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
     /// gets the void* slice array data of this DGPort.
     /// this only works for non-array DGPorts (isArray() == false)
     /// the bufferSize has to match getSliceCount() * getDataSize()
@@ -171,6 +312,143 @@ namespace FabricSpliceImpl
     /// the bufferSize has to match getSliceCount() * getDataSize()
     bool setAllSlicesData(void * buffer, uint32_t bufferSize, std::string * errorOut = NULL);
 
+    /// returns true if the data of a single slice can be accessed as a raw
+    /// buffer of the given size, which is the case for shallow non-array
+    /// DGPorts whose getDataSize() matches.
+    bool checkSliceDataSize(uint32_t dataSize, std::string * errorOut = NULL);
+
+    /// gets the void* data of a single slice of this DGPort, without any Variant.
+    /// this only works for shallow non-array DGPorts (isArray() == false)
+    /// the bufferSize has to match getDataSize()
+    /// DGNodes with more than one slice read the single slice through an RTVal,
+    /// which allocates, only single slice DGNodes are copied without any.
+    bool getSliceData(void * buffer, uint32_t bufferSize, uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// sets the void* data of a single slice of this DGPort, without any Variant.
+    /// this only works for shallow non-array DGPorts (isArray() == false)
+    /// the bufferSize has to match getDataSize()
+    /// DGNodes with more than one slice write the single slice through an RTVal,
+    /// which allocates, the other slices aren't touched.
+    bool setSliceData(const void * buffer, uint32_t bufferSize, uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// gets the array data of all slices of this DGPort as one concatenated buffer.
+    /// this only works for array DGPorts (isArray() == true)
+    /// offsets has to hold getSliceCount() + 1 entries, the elements of slice i
+    /// end up at [offsets[i], offsets[i+1]) within the buffer. if the buffer is NULL
+    /// only the offsets are returned, so that the buffer can be allocated.
+    bool getAllSlicesArrayData(
+        uint32_t * offsets,
+        uint32_t offsetsCount,
+        void * buffer,
+        uint32_t bufferSize,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the array data of all slices of this DGPort from one concatenated buffer.
+    /// this only works for array DGPorts (isArray() == true)
+    /// the slice count is set to offsetsCount - 1 and each slice's array is resized
+    /// to offsets[i+1] - offsets[i] elements.
+    bool setAllSlicesArrayData(
+        const uint32_t * offsets,
+        uint32_t offsetsCount,
+        void * buffer,
+        uint32_t bufferSize,
+        std::string * errorOut = NULL
+        );
+
+    /// gets the strings of this DGPort as one packed UTF-8 buffer, without terminators.
+    /// this only works for String DGPorts, the strings are the array elements of the
+    /// given slice for array DGPorts, or all slices otherwise.
+    /// offsets has to hold the string count + 1 entries, string i ends up at
+    /// [offsets[i], offsets[i+1]) within the buffer. if the buffer is NULL
+    /// only the offsets are returned, so that the buffer can be allocated.
+    bool getStringData(
+        uint32_t * offsets,
+        uint32_t offsetsCount,
+        char * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the strings of this DGPort from one packed UTF-8 buffer.
+    /// this only works for String DGPorts. for array DGPorts the array of the given
+    /// slice is resized to offsetsCount - 1, otherwise the slice count is set to it.
+    /// FabricCore has no flat access to KL strings, so both directions still cost one
+    /// RTVal per string. this saves the Variants, not the per string calls.
+    bool setStringData(
+        const uint32_t * offsets,
+        uint32_t offsetsCount,
+        const char * buffer,
+        uint32_t bufferSize,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// returns the array data of this DGPort converted into the given format.
+    /// this only works for array DGPorts whose data type consists of Float32 only
+    /// (like Vec3 or Color), each Float32 is converted into a scalar of the format.
+    /// the bufferSize has to match getArrayCount() * scalar count * format size
+    bool getArrayDataConverted(
+        void * buffer,
+        uint32_t bufferSize,
+        BulkIOImpl::DataFormat format,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the array data of this DGPort from a buffer of the given format.
+    /// this only works for array DGPorts whose data type consists of Float32 only.
+    /// this also sets the array count determined by the bufferSize
+    bool setArrayDataConverted(
+        void * buffer,
+        uint32_t bufferSize,
+        BulkIOImpl::DataFormat format,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// gets the slice array data of this DGPort converted into the given format.
+    /// this only works for non-array DGPorts whose data type consists of Float32 only.
+    bool getAllSlicesDataConverted(void * buffer, uint32_t bufferSize, BulkIOImpl::DataFormat format, std::string * errorOut = NULL);
+
+    /// sets the slice array data of this DGPort from a buffer of the given format.
+    /// this only works for non-array DGPorts whose data type consists of Float32 only.
+    bool setAllSlicesDataConverted(void * buffer, uint32_t bufferSize, BulkIOImpl::DataFormat format, std::string * errorOut = NULL);
+
+    /// returns the array data of a Mat44 or Xfo DGPort as 4x4 matrices of the given
+    /// order and format, Xfos are converted into matrices like Xfo.toMat44().
+    /// this only works for array DGPorts (isArray() == true)
+    /// the bufferSize has to match getArrayCount() * 16 * format size
+    bool getArrayDataMatrices(
+        void * buffer,
+        uint32_t bufferSize,
+        BulkIOImpl::MatrixOrder order,
+        BulkIOImpl::DataFormat format,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// sets the array data of a Mat44 DGPort from 4x4 matrices of the given order and format.
+    /// this only works for array DGPorts (isArray() == true)
+    /// this also sets the array count determined by the bufferSize
+    bool setArrayDataMatrices(
+        void * buffer,
+        uint32_t bufferSize,
+        BulkIOImpl::MatrixOrder order,
+        BulkIOImpl::DataFormat format,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// gets the slice array data of a Mat44 or Xfo DGPort as 4x4 matrices of the given order and format.
+    /// this only works for non-array DGPorts (isArray() == false)
+    bool getAllSlicesDataMatrices(void * buffer, uint32_t bufferSize, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, std::string * errorOut = NULL);
+
+    /// sets the slice array data of a Mat44 DGPort from 4x4 matrices of the given order and format.
+    /// this only works for non-array DGPorts (isArray() == false)
+    bool setAllSlicesDataMatrices(void * buffer, uint32_t bufferSize, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, std::string * errorOut = NULL);
+
     /// set the array data based on another port
     /// this performs data replication, and only works on shallow array data ports.
     /// the data type has to match as well (so only Vec3 to Vec3 for example).
@@ -181,6 +459,80 @@ namespace FabricSpliceImpl
     /// the data type has to match as well (so only Vec3 to Vec3 for example).
     bool copyAllSlicesDataFromDGPort(DGPortImplPtr other, bool resizeTarget = false, std::string * errorOut = NULL);
 
+    /// set the array data of all slices based on another port
+    /// this performs data replication, and only works on shallow array data ports.
+    /// the data type has to match as well (so only Vec3 to Vec3 for example).
+    bool copyAllSlicesArrayDataFromDGPort(DGPortImplPtr other, bool resizeTarget = false, std::string * errorOut = NULL);
+
+    /// copies the array data of a given slice of this DGPort into a buffer owned by
+    /// the DGPort and returns a pointer to it, count receives the number of elements.
+    /// this only works for shallow array DGPorts (isArray() == true).
+    /// this is a copy-in/copy-out convenience, not a view of the member storage: the
+    /// array is copied when acquired, and a writable copy is copied back into the member
+    /// on release. it costs the same copies as getArrayData and setArrayData, so prefer
+    /// those when the host has a buffer of its own. a copy still held when the DGPort
+    /// is destroyed is dropped. only one copy per DGPort can be held at a time.
+    void * acquireArrayDataCopy(
+        uint32_t & count,
+        bool writable = false,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// releases the copy previously acquired with acquireArrayDataCopy.
+    /// for writable copies the data is copied into the member and the graph requires evaluation.
+    bool releaseArrayDataCopy(std::string * errorOut = NULL);
+
+    /// returns true if this DGPort currently holds a copy of its array data
+    bool hasArrayDataCopy() const { return mHasArrayCopy; }
+
+    /// called once the DGPort no longer references a bound external buffer
+    typedef void (*ExternalArrayReleaseFunc)(void * data, void * userData);
+
+    /// binds a host owned buffer of count elements as the array data of a slice.
+    /// this only works for shallow array DGPorts (isArray() == true) which aren't outputs.
+    /// the buffer is read directly into the member right before the next evaluation,
+    /// so the host has to keep it alive until releaseFunc is called. binding a new
+    /// buffer (f.e. after the host reallocated) releases the previous one.
+    bool bindExternalArrayData(
+        void * data,
+        uint32_t count,
+        ExternalArrayReleaseFunc releaseFunc = NULL,
+        void * userData = NULL,
+        uint32_t slice = 0,
+        std::string * errorOut = NULL
+        );
+
+    /// marks the bound external buffer of a slice as modified in place,
+    /// it will be read again on the next evaluation.
+    bool invalidateExternalArrayData(uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// removes the external buffer binding of a slice and releases the buffer.
+    /// the member keeps the data which was read last.
+    bool unbindExternalArrayData(uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// returns true if an external buffer is bound to the given slice
+    bool isExternalArrayDataBound(uint32_t slice = 0) const;
+
+    /// returns the columns the data type of this DGPort is flattened into, as an array
+    /// of dicts with the keys 'path', 'dataType', 'elementSize' and 'variable'.
+    /// this works for struct and object DGPorts, shallow or not. members which can't be
+    /// flattened (dictionaries, interfaces, arrays of non shallow types) are left out.
+    FabricCore::Variant getColumnSchema(std::string * errorOut = NULL);
+
+    /// reads the given columns of all elements into flat buffers. the elements are the
+    /// array elements of the given slice for array DGPorts, or all slices otherwise.
+    /// for variable columns without data only the offsets are filled in, so that
+    /// the data can be allocated before calling this again.
+    bool getColumnData(ColumnData * columns, uint32_t columnCount, uint32_t slice = 0, std::string * errorOut = NULL);
+
+    /// writes the given columns of count elements from flat buffers. this resizes
+    /// the array of the given slice for array DGPorts, or sets the slice count otherwise.
+    /// columns which aren't provided keep their values, null objects are constructed.
+    /// the elements are accessed one by one as RTVals, and for array DGPorts the whole
+    /// array is copied back into the member, so this isn't a bulk copy like setArrayData.
+    bool setColumnData(const ColumnData * columns, uint32_t columnCount, uint32_t count, uint32_t slice = 0, std::string * errorOut = NULL);
+
     /*
       Auxiliary option management
     */
@@ -197,7 +549,39 @@ namespace FabricSpliceImpl
   private:
     DGPortImpl(DGGraphImplPtr thisGraph, const std::string & name, const std::string & member, FabricCore::DGNode dgNode, const std::string & dgNodeName, Mode mode, uint32_t dataSize, bool shallow, bool autoInitObjects);
 
+    // the graph resolved for the duration of an IO call. unlike a locked weak pointer
+    // this doesn't keep the graph alive, so graphs must not be destroyed while another
+    // thread calls into their DGPorts. debug builds count the calls in flight so
+    // that ~DGGraphImpl catches it, release builds don't pay for the counting.
+    class GraphRef
+    {
+    public:
+      explicit GraphRef(DGGraphImpl * graph);
+      GraphRef(const GraphRef & other);
+      ~GraphRef();
+      GraphRef & operator=(const GraphRef & other);
+      DGGraphImpl * operator->() const { return mGraph; }
+      bool operator!() const { return mGraph == NULL; }
+    private:
+      DGGraphImpl * mGraph;
+    };
+
+    // returns the graph through its registry slot, or NULL if it has been destroyed.
+    // this is used on the IO paths instead of locking the weak pointer. an asynchronous
+    // evaluation in flight is waited for, or cancelled if the caller is writing.
+    // the IO methods call this first, before they touch mDGNode.
+    GraphRef resolveDGGraph(bool writing = false) const;
+
+    // reports the destroyed graph for the given function, always returns false.
+    // kept out of line so that the message is only built on failure.
+    bool reportGraphDestroyed(const char * function) const;
+
+    // queries the struct, object and interface traits of the data type on first use
+    void resolveTypeTraits() const;
+
     DGGraphImplWeakPtr mGraph;
+    uint32_t mGraphSlot;
+    uint32_t mGraphGeneration;
     std::string mGraphName;
     std::string mKey;
     std::string mMember;
@@ -208,12 +592,80 @@ namespace FabricSpliceImpl
     std::string mDataType;
     bool mIsShallow;
     bool mIsArray;
-    bool mIsStruct;
-    bool mIsObject;
-    bool mIsInterface;
+    mutable bool mTypeTraitsResolved;
+    mutable bool mIsStruct;
+    mutable bool mIsObject;
+    mutable bool mIsInterface;
     uint32_t mDataSize;
+    // the buffer size get/setSliceData accept without further checks,
+    // 0 if the slices can't be accessed as raw buffers
+    uint32_t mSliceDataSize;
     // int mManipulatable;
     std::map<std::string,FabricCore::Variant> mOptions;
+    TypeLayoutImplPtr mTypeLayout;
+    uint32_t mTypeLayoutGeneration;
+
+    // copies a single array slice through the scratch buffer
+    bool copyArraySliceFromDGPort(DGPortImplPtr other, uint32_t slice, uint32_t otherSlice, std::string * errorOut);
+
+    // returns a per-thread buffer of at least the given size, reused across calls.
+    // callers keep a ScratchBufferScope, which releases it again once it grew too large
+    static void * getScratchBuffer(uint32_t size);
+
+    // returns the memory layout of the data type, determined on first use
+    TypeLayoutImplPtr getTypeLayout(std::string * errorOut = NULL);
+
+    // returns the layout used to encode / decode JSON directly, or an empty
+    // pointer if the JSON IO has to go through FabricCore::Variant
+    TypeLayoutImplPtr getJSONLayout();
+    int mJSONCodecSupport;
+
+    // sets a slice from JSON through FabricCore::Variant
+    bool setJSONVariant(const std::string & json, uint32_t slice, std::string * errorOut);
+
+    // maps the column buffers onto the columns of the layout
+    bool getColumnBuffers(ColumnLayoutImplPtr layout, const ColumnData * columns, uint32_t columnCount, std::vector<ColumnLayoutImpl::Buffer> & storage, std::vector<ColumnLayoutImpl::Buffer*> & buffers, std::string * errorOut);
+
+    // resolves the byte offset and size of a field within the data type
+    bool getFieldLayout(const char * field, uint32_t & offset, uint32_t & size, std::string * errorOut);
+
+    // returns the number of Float32 scalars per element for the converting IO
+    bool getFloat32ScalarCount(uint32_t & scalarCount, std::string * errorOut);
+
+    // checks the data type for the matrix IO, only Mat44 can be written
+    bool getMatrixSource(bool writing, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, bool & isXfo, std::string * errorOut);
+    void convertToMatrices(void * buffer, BulkIOImpl::MatrixOrder order, BulkIOImpl::DataFormat format, bool isXfo, const void * storage, uint32_t count);
+
+    // access to a copy of the array of a single slice, commit writes it back as a whole
+    void * accessArrayStorage(FabricCore::RTVal & arrayVal, uint32_t slice, uint32_t & count);
+    void commitArrayStorage(FabricCore::RTVal & arrayVal, uint32_t slice);
+
+    // resizes a single array slice, the elements within the new count are kept
+    void resizeArraySlice(uint32_t slice, uint32_t count);
+
+    // reads all modified external buffers into the member, called by the DGGraphImpl
+    // before evaluating
+    bool syncExternalArrayData(std::string * errorOut = NULL);
+    bool hasExternalArrayData() const { return mExternalArrays.size() > 0; }
+
+    struct ExternalArray
+    {
+      void * data;
+      uint32_t count;
+      ExternalArrayReleaseFunc releaseFunc;
+      void * userData;
+      bool requiresSync;
+    };
+    typedef std::map<uint32_t, ExternalArray> ExternalArrayMap;
+    ExternalArrayMap mExternalArrays;
+
+    // state of the array data copy held by acquireArrayDataCopy
+    bool mHasArrayCopy;
+    FabricCore::RTVal mArrayCopy;
+    void * mArrayCopyData;
+    uint32_t mArrayCopyCount;
+    uint32_t mArrayCopySlice;
+    bool mArrayCopyWritable;
   };
 
   typedef std::map<std::string, DGPortImplPtr> DGPortMap;
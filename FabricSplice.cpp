@@ -3,7 +3,11 @@
 #include "LoggingImpl.h"
 #include "SceneManagementImpl.h"
 #include "DGGraphImpl.h"
+#include "DGPortIOPlanImpl.h"
+#include "DGEvaluationImpl.h"
 #include "KLParserImpl.h"
+#include "BulkIOImpl.h"
+#include "ThreadPoolImpl.h"
 #include "FabricSplice.h"
 
 #define quoted(s) #s
@@ -61,6 +65,8 @@ void FECS_Finalize()
   FECS_TRY_CLEARERROR
   if(!gInitialized)
     return;
+  DGEvaluationImpl::shutdown();
+  ThreadPoolImpl::shutdown();
   FabricCore::Finalize();
   LoggingImpl::log("Finalized FabricSplice.");
   gInitialized = false;
@@ -147,6 +153,13 @@ FECS_DECL void FECS_setDCCOperatorSourceCodeCallback(FECS_GetOperatorSourceCodeF
   FECS_CATCH_VOID
 }
 
+void FECS_setParallelCopy(bool enabled, unsigned int threadCount, uint64_t threshold, bool nonTemporal)
+{
+  FECS_TRY_CLEARERROR
+  BulkIOImpl::setParallelCopy(enabled, threadCount, threshold, nonTemporal);
+  FECS_CATCH_VOID
+}
+
 void FECS_ConstructRTVal(FabricCore::RTVal & result, const char * rt)
 {
   FECS_TRY_CLEARERROR
@@ -1769,6 +1782,20 @@ bool FECS_DGGraph_evaluate(FECS_DGGraphRef ref)
   FECS_CATCH(false);
 }
 
+bool FECS_DGGraph_evaluateAll(const FECS_DGGraphRef * refs, unsigned int count, bool parallel, bool * results)
+{
+  FECS_TRY_CLEARERROR
+  std::vector<DGGraphImplPtr> graphs(count);
+  for(unsigned int i=0;i<count;i++)
+  {
+    DGGraphImplPtr * ptr = (DGGraphImplPtr *)refs[i];
+    if(ptr != NULL)
+      graphs[i] = *ptr;
+  }
+  return DGGraphImpl::evaluateAll(graphs, parallel, results);
+  FECS_CATCH(false);
+}
+
 void FECS_DGGraph_setEvaluateShared(FECS_DGGraphRef ref, bool evaluateShared)
 {
   FECS_TRY_CLEARERROR
@@ -1777,6 +1804,41 @@ void FECS_DGGraph_setEvaluateShared(FECS_DGGraphRef ref, bool evaluateShared)
   FECS_CATCH_VOID;
 }
 
+FECS_DGEvaluationRef FECS_DGGraph_evaluateAsync(FECS_DGGraphRef ref, FECS_DGEvaluationFunc func, void * userData)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGGraphImplPtr, graph, NULL)
+  DGEvaluationImplPtr evaluation = graph->evaluateAsync(func, userData);
+  if(!evaluation)
+    return NULL;
+  return new DGEvaluationImplPtr(evaluation);
+  FECS_CATCH(NULL);
+}
+
+bool FECS_DGGraph_isEvaluating(FECS_DGGraphRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGGraphImplPtr, graph, false)
+  return graph->isEvaluating();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGGraph_waitForEvaluation(FECS_DGGraphRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGGraphImplPtr, graph, false)
+  return graph->waitForEvaluation();
+  FECS_CATCH(false);
+}
+
+void FECS_DGGraph_cancelEvaluation(FECS_DGGraphRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTRVOID(DGGraphImplPtr, graph)
+  graph->cancelEvaluation();
+  FECS_CATCH_VOID;
+}
+
 bool FECS_DGGraph_clearEvaluate(FECS_DGGraphRef ref)
 {
   FECS_TRY_CLEARERROR
@@ -2152,6 +2214,38 @@ bool FECS_DGPort_setVariant(FECS_DGPortRef ref, const FabricCore::Variant & valu
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_setDictValues(FECS_DGPortRef ref, const FabricCore::Variant & values, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setDictValues(values, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_removeDictValue(FECS_DGPortRef ref, const char * key, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->removeDictValue(key, slice);
+  FECS_CATCH(false);
+}
+
+void FECS_DGPort_getVariants(FECS_DGPortRef ref, unsigned int start, unsigned int count, FabricCore::Variant & result)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTRVOID(DGPortImplPtr, port)
+  result = port->getVariants(start, count);
+  FECS_CATCH_VOID
+}
+
+bool FECS_DGPort_setAllSlicesFromVariantArray(FECS_DGPortRef ref, const FabricCore::Variant & values)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setAllSlicesFromVariantArray(values);
+  FECS_CATCH(false);
+}
+
 char * FECS_DGPort_getJSON(FECS_DGPortRef ref, unsigned int slice)
 {
   FECS_TRY_CLEARERROR
@@ -2205,6 +2299,20 @@ bool FECS_DGPort_setRTVal(
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_getRTVals(
+  FECS_DGPortRef ref,
+  FabricCore::RTVal * results,
+  unsigned int start,
+  unsigned int count,
+  bool evaluate
+  )
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getRTVals(results, start, count, evaluate);
+  FECS_CATCH(false);
+}
+
 unsigned int FECS_DGPort_getArrayCount(FECS_DGPortRef ref, unsigned int slice)
 {
   FECS_TRY_CLEARERROR
@@ -2239,6 +2347,105 @@ bool FECS_DGPort_setArrayData(
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_getArrayDataRange(FECS_DGPortRef ref, void * buffer, unsigned int offset, unsigned int count, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getArrayDataRange(buffer, offset, count, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setArrayDataRange(FECS_DGPortRef ref, void * buffer, unsigned int offset, unsigned int count, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setArrayDataRange(buffer, offset, count, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_gatherArrayData(FECS_DGPortRef ref, const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->gatherArrayData(indices, indexCount, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_scatterArrayData(FECS_DGPortRef ref, const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->scatterArrayData(indices, indexCount, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getArrayDataStrided(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int stride, unsigned int offset, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getArrayDataStrided(buffer, bufferSize, stride, offset, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setArrayDataStrided(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int count, unsigned int stride, unsigned int offset, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setArrayDataStrided(buffer, bufferSize, count, stride, offset, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getArrayField(FECS_DGPortRef ref, const char * field, void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getArrayField(field, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setArrayField(FECS_DGPortRef ref, const char * field, void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setArrayField(field, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+// the data formats pass the C API as plain integers, so unknown values are rejected here
+static bool checkDataFormat(FECS_DataFormat format, const char * function)
+{
+  if(BulkIOImpl::getDataFormatSize((BulkIOImpl::DataFormat)format) == 0)
+    return LoggingImpl::reportError(std::string(function)+", unknown data format.");
+  return true;
+}
+
+static bool checkMatrixOrder(FECS_MatrixOrder order, const char * function)
+{
+  if(order != FECS_MatrixOrder_RowMajor && order != FECS_MatrixOrder_ColumnMajor)
+    return LoggingImpl::reportError(std::string(function)+", unknown matrix order.");
+  return true;
+}
+
+bool FECS_DGPort_getArrayDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_getArrayDataConverted"))
+    return false;
+  return port->getArrayDataConverted(buffer, bufferSize, (BulkIOImpl::DataFormat)format, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setArrayDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_setArrayDataConverted"))
+    return false;
+  return port->setArrayDataConverted(buffer, bufferSize, (BulkIOImpl::DataFormat)format, slice);
+  FECS_CATCH(false);
+}
+
 bool FECS_DGPort_getAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize)
 {
   FECS_TRY_CLEARERROR
@@ -2247,6 +2454,30 @@ bool FECS_DGPort_getAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned in
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_checkSliceDataSize(FECS_DGPortRef ref, unsigned int dataSize)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->checkSliceDataSize(dataSize);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getSliceData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getSliceData(buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setSliceData(FECS_DGPortRef ref, const void * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setSliceData(buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
 bool FECS_DGPort_setAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize)
 {
   FECS_TRY_CLEARERROR
@@ -2255,6 +2486,98 @@ bool FECS_DGPort_setAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned in
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_getAllSlicesArrayData(FECS_DGPortRef ref, unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getAllSlicesArrayData(offsets, offsetsCount, buffer, bufferSize);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setAllSlicesArrayData(FECS_DGPortRef ref, const unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setAllSlicesArrayData(offsets, offsetsCount, buffer, bufferSize);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getStringData(FECS_DGPortRef ref, unsigned int * offsets, unsigned int offsetsCount, char * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getStringData(offsets, offsetsCount, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setStringData(FECS_DGPortRef ref, const unsigned int * offsets, unsigned int offsetsCount, const char * buffer, unsigned int bufferSize, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setStringData(offsets, offsetsCount, buffer, bufferSize, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getAllSlicesDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_getAllSlicesDataConverted"))
+    return false;
+  return port->getAllSlicesDataConverted(buffer, bufferSize, (BulkIOImpl::DataFormat)format);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setAllSlicesDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_setAllSlicesDataConverted"))
+    return false;
+  return port->setAllSlicesDataConverted(buffer, bufferSize, (BulkIOImpl::DataFormat)format);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getArrayDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_getArrayDataMatrices") || !checkMatrixOrder(order, "FECS_DGPort_getArrayDataMatrices"))
+    return false;
+  return port->getArrayDataMatrices(buffer, bufferSize, (BulkIOImpl::MatrixOrder)order, (BulkIOImpl::DataFormat)format, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setArrayDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_setArrayDataMatrices") || !checkMatrixOrder(order, "FECS_DGPort_setArrayDataMatrices"))
+    return false;
+  return port->setArrayDataMatrices(buffer, bufferSize, (BulkIOImpl::MatrixOrder)order, (BulkIOImpl::DataFormat)format, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_getAllSlicesDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_getAllSlicesDataMatrices") || !checkMatrixOrder(order, "FECS_DGPort_getAllSlicesDataMatrices"))
+    return false;
+  return port->getAllSlicesDataMatrices(buffer, bufferSize, (BulkIOImpl::MatrixOrder)order, (BulkIOImpl::DataFormat)format);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setAllSlicesDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  if(!checkDataFormat(format, "FECS_DGPort_setAllSlicesDataMatrices") || !checkMatrixOrder(order, "FECS_DGPort_setAllSlicesDataMatrices"))
+    return false;
+  return port->setAllSlicesDataMatrices(buffer, bufferSize, (BulkIOImpl::MatrixOrder)order, (BulkIOImpl::DataFormat)format);
+  FECS_CATCH(false);
+}
+
 bool FECS_DGPort_copyArrayDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef otherRef, unsigned int slice, unsigned int otherSlice)
 {
   FECS_TRY_CLEARERROR
@@ -2285,6 +2608,105 @@ bool FECS_DGPort_copyAllSlicesDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef ot
   FECS_CATCH(false);
 }
 
+bool FECS_DGPort_copyAllSlicesArrayDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef otherRef, bool resizeTarget)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  DGPortImplPtr * otherPtr = (DGPortImplPtr *)otherRef;
+  if(!otherPtr)
+  {
+    LoggingImpl::logError("Other port ref is NULL!");
+    return false;
+  }
+  DGPortImplPtr & otherPort = *otherPtr;
+  return port->copyAllSlicesArrayDataFromDGPort(otherPort, resizeTarget);
+  FECS_CATCH(false);
+}
+
+void * FECS_DGPort_acquireArrayDataCopy(FECS_DGPortRef ref, unsigned int * count, bool writable, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, NULL)
+  uint32_t copyCount = 0;
+  void * result = port->acquireArrayDataCopy(copyCount, writable, slice);
+  if(count)
+    *count = copyCount;
+  return result;
+  FECS_CATCH(NULL);
+}
+
+bool FECS_DGPort_releaseArrayDataCopy(FECS_DGPortRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->releaseArrayDataCopy();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_hasArrayDataCopy(FECS_DGPortRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->hasArrayDataCopy();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_bindExternalArrayData(FECS_DGPortRef ref, void * data, unsigned int count, FECS_ExternalArrayReleaseFunc releaseFunc, void * userData, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->bindExternalArrayData(data, count, (DGPortImpl::ExternalArrayReleaseFunc)releaseFunc, userData, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_invalidateExternalArrayData(FECS_DGPortRef ref, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->invalidateExternalArrayData(slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_unbindExternalArrayData(FECS_DGPortRef ref, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->unbindExternalArrayData(slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_isExternalArrayDataBound(FECS_DGPortRef ref, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->isExternalArrayDataBound(slice);
+  FECS_CATCH(false);
+}
+
+void FECS_DGPort_getColumnSchema(FECS_DGPortRef ref, FabricCore::Variant & result)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTRVOID(DGPortImplPtr, port)
+  result = port->getColumnSchema();
+  FECS_CATCH_VOID
+}
+
+bool FECS_DGPort_getColumnData(FECS_DGPortRef ref, FECS_ColumnData * columns, unsigned int columnCount, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->getColumnData((DGPortImpl::ColumnData *)columns, columnCount, slice);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPort_setColumnData(FECS_DGPortRef ref, const FECS_ColumnData * columns, unsigned int columnCount, unsigned int count, unsigned int slice)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortImplPtr, port, false)
+  return port->setColumnData((const DGPortImpl::ColumnData *)columns, columnCount, count, slice);
+  FECS_CATCH(false);
+}
+
 void FECS_DGPort_setOption(FECS_DGPortRef ref, const char * name, const FabricCore::Variant & value)
 {
   FECS_TRY_CLEARERROR
@@ -2301,6 +2723,150 @@ void FECS_DGPort_getOption(FECS_DGPortRef ref, const char * name, FabricCore::Va
   FECS_CATCH_VOID
 }
 
+FECS_DGPortIOPlanRef FECS_DGPortIOPlan_construct()
+{
+  FECS_TRY_CLEARERROR
+  return new DGPortIOPlanImplPtr(DGPortIOPlanImpl::construct());
+  FECS_CATCH(NULL);
+}
+
+FECS_DGPortIOPlanRef FECS_DGPortIOPlan_copy(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  DGPortIOPlanImplPtr * ptr = (DGPortIOPlanImplPtr *)ref;
+  if(ptr == NULL)
+    return NULL;
+  return new DGPortIOPlanImplPtr(*ptr);
+  FECS_CATCH(NULL);
+}
+
+void FECS_DGPortIOPlan_destroy(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  DGPortIOPlanImplPtr * ptr = (DGPortIOPlanImplPtr *)ref;
+  if(ptr != NULL)
+    delete(ptr);
+  FECS_CATCH_VOID
+}
+
+bool FECS_DGPortIOPlan_addEntry(FECS_DGPortIOPlanRef ref, FECS_DGPortRef portRef, void * buffer, unsigned int bufferSize, unsigned int slice, FECS_DGPort_Mode mode)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, false)
+  DGPortImplPtr * portPtr = (DGPortImplPtr *)portRef;
+  if(portPtr == NULL)
+    return LoggingImpl::reportError("FECS_DGPortIOPlan_addEntry, DGPort is not valid.");
+  return plan->addEntry(*portPtr, buffer, bufferSize, slice, (DGPortImpl::Mode)mode);
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPortIOPlan_setEntryBuffer(FECS_DGPortIOPlanRef ref, unsigned int index, void * buffer, unsigned int bufferSize)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, false)
+  return plan->setEntryBuffer(index, buffer, bufferSize);
+  FECS_CATCH(false);
+}
+
+unsigned int FECS_DGPortIOPlan_getEntryCount(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, 0)
+  return plan->getEntryCount();
+  FECS_CATCH(0);
+}
+
+void FECS_DGPortIOPlan_clear(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTRVOID(DGPortIOPlanImplPtr, plan)
+  plan->clear();
+  FECS_CATCH_VOID
+}
+
+bool FECS_DGPortIOPlan_validate(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, false)
+  return plan->validate();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPortIOPlan_isValidated(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, false)
+  return plan->isValidated();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGPortIOPlan_execute(FECS_DGPortIOPlanRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGPortIOPlanImplPtr, plan, false)
+  return plan->execute();
+  FECS_CATCH(false);
+}
+
+FECS_DGEvaluationRef FECS_DGEvaluation_copy(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  DGEvaluationImplPtr * ptr = (DGEvaluationImplPtr *)ref;
+  if(ptr == NULL)
+    return NULL;
+  return new DGEvaluationImplPtr(*ptr);
+  FECS_CATCH(NULL);
+}
+
+void FECS_DGEvaluation_destroy(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  DGEvaluationImplPtr * ptr = (DGEvaluationImplPtr *)ref;
+  if(ptr != NULL)
+    delete(ptr);
+  FECS_CATCH_VOID
+}
+
+char const * FECS_DGEvaluation_getGraphName(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGEvaluationImplPtr, evaluation, "")
+  return evaluation->getGraphName();
+  FECS_CATCH("");
+}
+
+FECS_DGEvaluation_State FECS_DGEvaluation_getState(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGEvaluationImplPtr, evaluation, FECS_DGEvaluation_State_Failed)
+  return (FECS_DGEvaluation_State)evaluation->getState();
+  FECS_CATCH(FECS_DGEvaluation_State_Failed);
+}
+
+bool FECS_DGEvaluation_isDone(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGEvaluationImplPtr, evaluation, false)
+  return evaluation->isDone();
+  FECS_CATCH(false);
+}
+
+bool FECS_DGEvaluation_wait(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTR(DGEvaluationImplPtr, evaluation, false)
+  return evaluation->wait();
+  FECS_CATCH(false);
+}
+
+void FECS_DGEvaluation_cancel(FECS_DGEvaluationRef ref)
+{
+  FECS_TRY_CLEARERROR
+  GETSMARTPTRVOID(DGEvaluationImplPtr, evaluation)
+  evaluation->cancel();
+  FECS_CATCH_VOID
+}
+
 // bool FECS_DGPort_isManipulatable(FECS_DGPortRef ref)
 // {
 //   FECS_TRY_CLEARERROR
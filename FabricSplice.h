@@ -115,6 +115,7 @@ All Fabric:Splice C++ classes are implemented within the :dfn:`FabricSplice` nam
   exception
   dggraph
   dgport
+  dgportioplan
   scenemanagement
   scripting
   klparser
@@ -179,6 +180,9 @@ The SPLICECAPI provides several global functions. These can be used to initializ
       // sit in the UI somewhere but hasn't been pushed to the DGGraph.
       void setDCCOperatorSourceCodeCallback(GetOperatorSourceCodeFunc func);
 
+      // enables the parallel copy for large array copies into host buffers
+      void SetParallelCopy(bool enabled, unsigned int threadCount = 0, uint64_t threshold = 16777216, bool nonTemporal = false);
+
       // creates a RTVal just given a KL type name
       FabricCore::RTVal constructRTVal(const char * rt);
 
@@ -1058,6 +1062,9 @@ The DGPort class allows to get or set :ref:`dggraph` data. DGPorts can communica
   that accesses to data on the same port are synchronized, ie. that two threads
   don't try to change the value at the same time.  However, it is safe to access
   data on different instances of FabricSplice::DFGPort without locking.
+  DGPorts don't keep their :ref:`dggraph` alive during a call, so a graph must
+  not be destroyed while another thread is accessing data on one of its DGPorts.
+  Debug builds assert on this.
   
 Example
 ---------------------------------
@@ -1152,6 +1159,32 @@ Class Outline
         Port_Mode_IO = 2
       };
 
+      enum DataFormat
+      {
+        DataFormat_Float32 = 0,
+        DataFormat_Float64 = 1,
+        DataFormat_Float16 = 2
+      };
+
+      enum MatrixOrder
+      {
+        MatrixOrder_RowMajor = 0,
+        MatrixOrder_ColumnMajor = 1
+      };
+
+      // a function called once a DGPort no longer references a bound external buffer
+      typedef void(*ExternalArrayReleaseFunc)(void * data, void * userData);
+
+      // the host buffers of a single column for the columnar IO
+      struct ColumnData
+      {
+        const char * path;
+        void * data;
+        unsigned int dataSize;
+        unsigned int * offsets;
+        unsigned int offsetsCount;
+      };
+
       class DGPort
       {
       public:
@@ -1230,6 +1263,21 @@ Class Outline
         // sets the value of a specific slice of this DGPort from a FabricCore::Variant
         bool setVariant(FabricCore::Variant value, unsigned int slice = 0);
 
+        // sets the given keys of a struct or KL Dict value of a specific slice from
+        // a FabricCore::Variant dictionary. keys which aren't part of values are left
+        // untouched, the graph is never evaluated.
+        bool setDictValues(const FabricCore::Variant & values, unsigned int slice = 0);
+
+        // removes a key from a KL Dict value of a specific slice
+        bool removeDictValue(const char * key, unsigned int slice = 0);
+
+        // returns the values of count slices starting at start as a FabricCore::Variant array
+        FabricCore::Variant getVariants(unsigned int start, unsigned int count);
+
+        // sets all slices of this DGPort from a FabricCore::Variant array,
+        // resizing the FabricCore::DGNode to the size of the array.
+        bool setAllSlicesFromVariantArray(const FabricCore::Variant & values);
+
         // returns the value of a specific slice of this DGPort as a JSON string
         std::string getJSON(unsigned int slice = 0);
 
@@ -1242,6 +1290,10 @@ Class Outline
         // returns the value of a specific slice of this DGPort as a FabricCore::RTVal
         FabricCore::RTVal getRTVal(bool evaluate = false, uint32_t slice = 0);
 
+        // returns the values of count slices starting at start as FabricCore::RTVals
+        // the results pointer has to provide room for count RTVals
+        bool getRTVals(FabricCore::RTVal * results, unsigned int start, unsigned int count, bool evaluate = false);
+
         // sets the value of a specific slice of this DGPort from a FabricCore::RTVal
         bool setRTVal(FabricCore::RTVal value, uint32_t slice = 0);
 
@@ -1258,6 +1310,48 @@ Class Outline
         // this also sets the array count determined by bufferSize / getDataSize()
         bool setArrayData(void * buffer, unsigned int bufferSize, unsigned int slice = 0);
 
+        // returns count elements of the array data of this DGPort starting at offset.
+        // this only works for array DGPorts (isArray() == true)
+        bool getArrayDataRange(void * buffer, unsigned int offset, unsigned int count, unsigned int slice = 0);
+
+        // sets count elements of the array data of this DGPort starting at offset.
+        // the array is not resized, offset + count has to be within getArrayCount().
+        // FabricCore only writes whole arrays, so this still copies the entire array.
+        bool setArrayDataRange(void * buffer, unsigned int offset, unsigned int count, unsigned int slice = 0);
+
+        // returns the array elements at the given indices into a tightly packed buffer.
+        // this only works for array DGPorts (isArray() == true)
+        bool gatherArrayData(const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // sets the array elements at the given indices from a tightly packed buffer.
+        // the array is not resized, for duplicate indices the last element wins.
+        // FabricCore only writes whole arrays, so this still copies the entire array.
+        bool scatterArrayData(const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // returns the array data of this DGPort into a strided buffer.
+        // element i is written to buffer + offset + i * stride, a stride of 0 means tightly packed.
+        // this only works for array DGPorts (isArray() == true)
+        bool getArrayDataStrided(void * buffer, unsigned int bufferSize, unsigned int stride, unsigned int offset = 0, unsigned int slice = 0);
+
+        // sets the array data of this DGPort from a strided buffer.
+        // element i is read from buffer + offset + i * stride, a stride of 0 means tightly packed.
+        // this only works for array DGPorts (isArray() == true)
+        bool setArrayDataStrided(void * buffer, unsigned int bufferSize, unsigned int count, unsigned int stride, unsigned int offset = 0, unsigned int slice = 0);
+
+        // returns a single field of all array elements (like "tr" of an Xfo[]) as a tightly packed buffer
+        bool getArrayField(const char * field, void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // sets a single field of all array elements from a tightly packed buffer
+        bool setArrayField(const char * field, void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // returns the array data of this DGPort converted into the given format.
+        // this only works for array DGPorts of Float32 based types (like Vec3 or Color)
+        bool getArrayDataConverted(void * buffer, unsigned int bufferSize, DataFormat format, unsigned int slice = 0);
+
+        // sets the array data of this DGPort from a buffer of the given format.
+        // this only works for array DGPorts of Float32 based types (like Vec3 or Color)
+        bool setArrayDataConverted(void * buffer, unsigned int bufferSize, DataFormat format, unsigned int slice = 0);
+
         // gets the void* slice array data of this DGPort.
         // this only works for non-array DGPorts (isArray() == false)
         // the bufferSize has to match getSliceCount() * getDataSize()
@@ -1268,6 +1362,67 @@ Class Outline
         // the bufferSize has to match getSliceCount() * getDataSize()
         bool setAllSlicesData(void * buffer, unsigned int bufferSize);
 
+        // gets the void* data of a single slice of a shallow non-array DGPort
+        bool getSliceData(void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // sets the void* data of a single slice of a shallow non-array DGPort
+        bool setSliceData(const void * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // returns the value of a single slice as T, which has to match the data size
+        template<typename T> T get(unsigned int slice = 0);
+
+        // sets the value of a single slice from T, which has to match the data size
+        template<typename T> bool set(const T & value, unsigned int slice = 0);
+
+        // a DGPort bound to a C++ type T, the data size is checked once on construction
+        template<typename T> class SliceAccessor
+        {
+        public:
+          SliceAccessor(DGPort & port);
+          T get(unsigned int slice = 0);
+          bool set(const T & value, unsigned int slice = 0);
+        };
+
+        // gets the array data of all slices of this DGPort as one concatenated buffer.
+        // this only works for array DGPorts (isArray() == true)
+        // offsets has to hold getSliceCount() + 1 entries, the elements of slice i
+        // end up at [offsets[i], offsets[i+1]) within the buffer. if the buffer is NULL
+        // only the offsets are returned, so that the buffer can be allocated.
+        bool getAllSlicesArrayData(unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize);
+
+        // sets the array data of all slices of this DGPort from one concatenated buffer.
+        // the slice count is set to offsetsCount - 1 and each slice's array is resized
+        // to offsets[i+1] - offsets[i] elements.
+        bool setAllSlicesArrayData(const unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize);
+
+        // gets the strings of a String DGPort as one packed UTF-8 buffer plus offsets.
+        // if the buffer is NULL only the offsets are returned.
+        bool getStringData(unsigned int * offsets, unsigned int offsetsCount, char * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // sets the strings of a String DGPort from one packed UTF-8 buffer plus offsets.
+        // both directions still cost one RTVal per string.
+        bool setStringData(const unsigned int * offsets, unsigned int offsetsCount, const char * buffer, unsigned int bufferSize, unsigned int slice = 0);
+
+        // gets the slice array data of this DGPort converted into the given format.
+        // this only works for non-array DGPorts of Float32 based types (like Vec3 or Color)
+        bool getAllSlicesDataConverted(void * buffer, unsigned int bufferSize, DataFormat format);
+
+        // sets the slice array data of this DGPort from a buffer of the given format.
+        // this only works for non-array DGPorts of Float32 based types (like Vec3 or Color)
+        bool setAllSlicesDataConverted(void * buffer, unsigned int bufferSize, DataFormat format);
+
+        // returns the array data of a Mat44 or Xfo DGPort as 4x4 matrices of the given order and format
+        bool getArrayDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format, unsigned int slice = 0);
+
+        // sets the array data of a Mat44 DGPort from 4x4 matrices of the given order and format
+        bool setArrayDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format, unsigned int slice = 0);
+
+        // gets the slice array data of a Mat44 or Xfo DGPort as 4x4 matrices of the given order and format
+        bool getAllSlicesDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format);
+
+        // sets the slice array data of a Mat44 DGPort from 4x4 matrices of the given order and format
+        bool setAllSlicesDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format);
+
         // set the array data based on another port
         // this performs data replication, and only works on shallow array data ports.
         // the data type has to match as well (so only Vec3 to Vec3 for example).
@@ -1278,6 +1433,49 @@ Class Outline
         // the data type has to match as well (so only Vec3 to Vec3 for example).
         bool copyAllSlicesDataFromDGPort(DGPort other, bool resizeTarget = false);
 
+        // set the array data of all slices based on another port
+        // this performs data replication, and only works on shallow array data ports.
+        // the data type has to match as well (so only Vec3 to Vec3 for example).
+        bool copyAllSlicesArrayDataFromDGPort(DGPort other, bool resizeTarget = false);
+
+        // copies the array data of a slice into a buffer owned by the DGPort and returns it.
+        // this only works for shallow array DGPorts (isArray() == true).
+        // this is a copy-in/copy-out convenience costing the same copies as getArrayData and
+        // setArrayData. writable copies are copied back into the member and dirty the graph
+        // on releaseArrayDataCopy(), a copy left on destruction is dropped.
+        void * acquireArrayDataCopy(unsigned int & count, bool writable = false, unsigned int slice = 0);
+
+        // releases the copy acquired by acquireArrayDataCopy
+        bool releaseArrayDataCopy();
+
+        // returns true if this DGPort currently holds a copy of its array data
+        bool hasArrayDataCopy();
+
+        // binds a host owned buffer of count elements as the array data of a slice.
+        // this only works for shallow array DGPorts (isArray() == true) which aren't outputs.
+        // the buffer is read directly into the member right before the next evaluation,
+        // so the host has to keep it alive until releaseFunc is called. binding a new
+        // buffer (f.e. after the host reallocated) releases the previous one.
+        bool bindExternalArrayData(void * data, unsigned int count, ExternalArrayReleaseFunc releaseFunc = NULL, void * userData = NULL, unsigned int slice = 0);
+
+        // marks the bound external buffer of a slice as modified in place
+        bool invalidateExternalArrayData(unsigned int slice = 0);
+
+        // removes the external buffer binding of a slice and releases the buffer
+        bool unbindExternalArrayData(unsigned int slice = 0);
+
+        // returns true if an external buffer is bound to the given slice
+        bool isExternalArrayDataBound(unsigned int slice = 0);
+
+        // returns the columns the data type of this DGPort is flattened into
+        FabricCore::Variant getColumnSchema();
+
+        // reads the given columns of all elements into flat buffers
+        bool getColumnData(ColumnData * columns, unsigned int columnCount, unsigned int slice = 0);
+
+        // writes the given columns of count elements from flat buffers
+        bool setColumnData(const ColumnData * columns, unsigned int columnCount, unsigned int count, unsigned int slice = 0);
+
         // sets an auxiliary option
         void setOption(const char * name, const FabricCore::Variant & value);
 
@@ -1314,6 +1512,170 @@ Class Outline
       };
     };
 */
+/*SPHINX:dgportioplan
+
+.. _dgportioplan:
+
+FabricSplice::DGPortIOPlan
+=========================
+
+The DGPortIOPlan class batches the high performance IO of several :ref:`dgport` objects. The plan is built once from a list of entries, each describing a port, a buffer, a slice and a direction. All checks are performed once during validation, executing the plan writes all inputs, evaluates each affected graph once and reads all outputs.
+
+Example
+---------------------------------
+
+.. code-block:: c++
+
+    // build the plan once
+    DGPortIOPlan plan;
+    plan.addEntry(positionsPort, &positions[0], sizeof(float) * 3 * positions.size(), 0, Port_Mode_IN);
+    plan.addEntry(deformedPort, &deformed[0], sizeof(float) * 3 * deformed.size(), 0, Port_Mode_OUT);
+    plan.validate();
+
+    // then per frame
+    plan.execute();
+
+Class Outline
+---------------------------------
+
+.. code-block:: c++
+
+    namespace FabricSplice
+    {
+      class DGPortIOPlan
+      {
+      public:
+
+        // creates an empty plan
+        DGPortIOPlan();
+
+        // copy constructor
+        DGPortIOPlan(DGPortIOPlan const & other);
+
+        // assignment operator
+        DGPortIOPlan & operator =( DGPortIOPlan const & other );
+
+        // default destructor
+        ~DGPortIOPlan();
+
+        // returns true if the object is valid
+        bool isValid() const;
+
+        // bool conversion operator
+        operator bool() const;
+
+        // adds an entry. mode has to be Port_Mode_IN (buffer to port)
+        // or Port_Mode_OUT (port to buffer). for array ports the buffer covers
+        // the array of the slice, for non-array ports it covers all slices.
+        bool addEntry(DGPort port, void * buffer, unsigned int bufferSize, unsigned int slice = 0, Port_Mode mode = Port_Mode_IN);
+
+        // changes the buffer of an existing entry without invalidating the plan
+        bool setEntryBuffer(unsigned int index, void * buffer, unsigned int bufferSize);
+
+        // returns the number of entries
+        unsigned int getEntryCount();
+
+        // removes all entries
+        void clear();
+
+        // performs all checks for all entries once
+        bool validate();
+
+        // returns true if the plan has been validated since the last change
+        bool isValidated();
+
+        // writes all inputs, evaluates once and reads all outputs
+        bool execute();
+      };
+    };
+*/
+/*SPHINX:dgevaluation
+
+.. _dgevaluation:
+
+FabricSplice::DGEvaluation
+=========================
+
+The DGEvaluation class is the handle of an asynchronous evaluation started with DGGraph::evaluateAsync. The evaluation runs on a background thread, so the host's UI thread isn't blocked while the KL operators run. A new evaluation supersedes the one in flight. While an evaluation is in flight, reading a :ref:`dgport` waits for it to finish, writing a :ref:`dgport` or changing the graph cancels it first. Graphs meant to be evaluated asynchronously should use a client constructed with FabricCore::ClientOptimizationType_Background.
+
+Example
+---------------------------------
+
+.. code-block:: c++
+
+    // called on the background thread, must not access the graph
+    void onEvaluated(const char * graphName, int state, void * userData)
+    {
+      if(state == DGEvaluation_State_Succeeded)
+        requestRedraw(userData);
+    }
+
+    // on input changes
+    inputPort.setVariant(FabricCore::Variant::CreateFloat64(time));
+    DGEvaluation evaluation = graph.evaluateAsync(onEvaluated, view);
+
+    // on redraw, this returns right away once the evaluation is done
+    FabricCore::Variant result = outputPort.getVariant();
+
+Class Outline
+---------------------------------
+
+.. code-block:: c++
+
+    namespace FabricSplice
+    {
+      enum DGEvaluation_State
+      {
+        DGEvaluation_State_Pending = 0,
+        DGEvaluation_State_Running = 1,
+        DGEvaluation_State_Succeeded = 2,
+        DGEvaluation_State_Failed = 3,
+        DGEvaluation_State_Cancelled = 4
+      };
+
+      // a function called once an asynchronous evaluation is done, on the background thread
+      typedef void(*DGEvaluationFunc)(const char * graphName, int state, void * userData);
+
+      class DGEvaluation
+      {
+      public:
+
+        // creates an empty handle
+        DGEvaluation();
+
+        // copy constructor
+        DGEvaluation(DGEvaluation const & other);
+
+        // assignment operator
+        DGEvaluation & operator =( DGEvaluation const & other );
+
+        // default destructor
+        ~DGEvaluation();
+
+        // returns true if the object is valid
+        bool isValid() const;
+
+        // bool conversion operator
+        operator bool() const;
+
+        // returns the name of the evaluated graph
+        char const * getGraphName();
+
+        // returns the current state
+        DGEvaluation_State getState();
+
+        // returns true if the evaluation succeeded, failed or has been cancelled
+        bool isDone();
+
+        // blocks until the evaluation is done, returns true if it succeeded
+        bool wait();
+
+        // cancels the evaluation without waiting for it. a pending evaluation
+        // doesn't start, a running one stops after the current level.
+        void cancel();
+      };
+    };
+*/
 /*SPHINX:dggraph
 
 .. _dggraph:
@@ -1546,9 +1908,27 @@ Class Outline
         // checks all FabricCore::DGNodes and FabricCore::Operators for errors, return false if any errors found
         static bool checkErrors();
 
-        // evaluates the contained DGNode
+        // evaluates the contained DGNodes. if the graph evaluates shared, DGNodes
+        // without a dependency path between them are evaluated in parallel
         bool evaluate();
 
+        // evaluates the dirty DGNodes of several DGGraphs, checking for errors only once.
+        // graphs evaluating shared are spread across host threads if parallel is true.
+        static bool evaluateAll(DGGraph * graphs, unsigned int count, bool parallel = true, bool * results = NULL);
+
+        // evaluates the dirty DGNodes on a background thread, func is called once done.
+        // a new evaluation supersedes the one in flight.
+        DGEvaluation evaluateAsync(DGEvaluationFunc func = NULL, void * userData = NULL);
+
+        // returns true if an asynchronous evaluation is in flight
+        bool isEvaluating();
+
+        // waits for the asynchronous evaluation in flight, returns false if it failed
+        bool waitForEvaluation();
+
+        // cancels the asynchronous evaluation in flight and waits for it to stop
+        void cancelEvaluation();
+
         // clears the evaluate state
         bool clearEvaluate();
 
@@ -1689,6 +2069,7 @@ Class Outline
 
 #include <limits.h>
 #include <stdlib.h>
+#include <vector>
 #include <FabricCore.h>
 
 // C typedefs
@@ -1736,8 +2117,19 @@ struct FECS_PersistenceInfo
   FabricCore::Variant filePath;
 };
 
+struct FECS_ColumnData
+{
+  const char * path;
+  void * data;
+  unsigned int dataSize;
+  unsigned int * offsets;
+  unsigned int offsetsCount;
+};
+
 typedef void * FECS_DGGraphRef;
 typedef void * FECS_DGPortRef;
+typedef void * FECS_DGPortIOPlanRef;
+typedef void * FECS_DGEvaluationRef;
 typedef void * FECS_KLParserRef;
 typedef void * FECS_KLParserSymbolRef;
 typedef void * FECS_KLParserConstantRef;
@@ -1752,6 +2144,8 @@ typedef void(*FECS_CompilerErrorFunc)(unsigned int row, unsigned int col, const
 typedef void(*FECS_StatusFunc)(const char * topic, unsigned int topicLength, const char * message, unsigned int messageLength);
 typedef void(*FECS_SlowOperationFunc)(const char *descCStr, unsigned int descLength );
 typedef const char *(*FECS_GetOperatorSourceCodeFunc)(const char * graphName, const char * opName);
+typedef void(*FECS_ExternalArrayReleaseFunc)(void * data, void * userData);
+typedef void(*FECS_DGEvaluationFunc)(const char * graphName, int state, void * userData);
 
 enum FECS_DGPort_Mode
 {
@@ -1760,6 +2154,28 @@ enum FECS_DGPort_Mode
   FECS_DGPort_Mode_IO = 2
 };
 
+enum FECS_DataFormat
+{
+  FECS_DataFormat_Float32 = 0,
+  FECS_DataFormat_Float64 = 1,
+  FECS_DataFormat_Float16 = 2
+};
+
+enum FECS_MatrixOrder
+{
+  FECS_MatrixOrder_RowMajor = 0,
+  FECS_MatrixOrder_ColumnMajor = 1
+};
+
+enum FECS_DGEvaluation_State
+{
+  FECS_DGEvaluation_State_Pending = 0,
+  FECS_DGEvaluation_State_Running = 1,
+  FECS_DGEvaluation_State_Succeeded = 2,
+  FECS_DGEvaluation_State_Failed = 3,
+  FECS_DGEvaluation_State_Cancelled = 4
+};
+
 typedef FEC_LockType FECS_LockType;
 #define FECS_LockType_Shared FEC_LockType_Shared
 #define FECS_LockType_Exclusive FEC_LockType_Exclusive
@@ -1779,6 +2195,7 @@ FECS_DECL bool FECS_destroyClient(bool force);
 FECS_DECL char const * FECS_GetClientContextID();
 FECS_DECL bool FECS_addExtFolder(const char * folder);
 FECS_DECL void FECS_setDCCOperatorSourceCodeCallback(FECS_GetOperatorSourceCodeFunc func);
+FECS_DECL void FECS_setParallelCopy(bool enabled, unsigned int threadCount, uint64_t threshold, bool nonTemporal);
 FECS_DECL void FECS_ConstructRTVal(FabricCore::RTVal & result, const char * rt);
 FECS_DECL void FECS_ConstructRTValArgs(FabricCore::RTVal & result, const char * rt, uint32_t nbArgs, const FabricCore::RTVal * args);
 FECS_DECL void FECS_ConstructObjectRTVal(FabricCore::RTVal & result, const char * rt);
@@ -1960,6 +2377,11 @@ FECS_DECL char const * FECS_DGGraph_getGlobalKLOperatorName(unsigned int index);
 FECS_DECL bool FECS_DGGraph_checkErrors();
 FECS_DECL void FECS_DGGraph_setEvaluateShared(FECS_DGGraphRef ref, bool evaluateShared);
 FECS_DECL bool FECS_DGGraph_evaluate(FECS_DGGraphRef ref);
+FECS_DECL bool FECS_DGGraph_evaluateAll(const FECS_DGGraphRef * refs, unsigned int count, bool parallel, bool * results);
+FECS_DECL FECS_DGEvaluationRef FECS_DGGraph_evaluateAsync(FECS_DGGraphRef ref, FECS_DGEvaluationFunc func, void * userData);
+FECS_DECL bool FECS_DGGraph_isEvaluating(FECS_DGGraphRef ref);
+FECS_DECL bool FECS_DGGraph_waitForEvaluation(FECS_DGGraphRef ref);
+FECS_DECL void FECS_DGGraph_cancelEvaluation(FECS_DGGraphRef ref);
 FECS_DECL bool FECS_DGGraph_clearEvaluate(FECS_DGGraphRef ref);
 FECS_DECL bool FECS_DGGraph_usesEvalContext(FECS_DGGraphRef ref);
 FECS_DECL bool FECS_DGGraph_requireEvaluate(FECS_DGGraphRef ref);
@@ -2005,20 +2427,77 @@ FECS_DECL unsigned int FECS_DGPort_getSliceCount(FECS_DGPortRef ref);
 FECS_DECL bool FECS_DGPort_setSliceCount(FECS_DGPortRef ref, unsigned int count); 
 FECS_DECL void FECS_DGPort_getVariant(FECS_DGPortRef ref, unsigned int slice, FabricCore::Variant & result);
 FECS_DECL bool FECS_DGPort_setVariant(FECS_DGPortRef ref, const FabricCore::Variant & value, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setDictValues(FECS_DGPortRef ref, const FabricCore::Variant & values, unsigned int slice);
+FECS_DECL bool FECS_DGPort_removeDictValue(FECS_DGPortRef ref, const char * key, unsigned int slice);
+FECS_DECL void FECS_DGPort_getVariants(FECS_DGPortRef ref, unsigned int start, unsigned int count, FabricCore::Variant & result);
+FECS_DECL bool FECS_DGPort_setAllSlicesFromVariantArray(FECS_DGPortRef ref, const FabricCore::Variant & values);
 FECS_DECL char * FECS_DGPort_getJSON(FECS_DGPortRef ref, unsigned int slice);
 FECS_DECL bool FECS_DGPort_setJSON(FECS_DGPortRef ref, const char * json, unsigned int slice);
 FECS_DECL void FECS_DGPort_getDefault(FECS_DGPortRef ref, FabricCore::Variant & result);
 FECS_DECL void FECS_DGPort_getRTVal(FECS_DGPortRef ref, bool evaluate, unsigned int slice, FabricCore::RTVal & result);
 FECS_DECL bool FECS_DGPort_setRTVal(FECS_DGPortRef ref, const FabricCore::RTVal & value, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getRTVals(FECS_DGPortRef ref, FabricCore::RTVal * results, unsigned int start, unsigned int count, bool evaluate);
 FECS_DECL unsigned int FECS_DGPort_getArrayCount(FECS_DGPortRef ref, unsigned int slice);
 FECS_DECL bool FECS_DGPort_getArrayData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int slice);
 FECS_DECL bool FECS_DGPort_setArrayData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getArrayDataRange(FECS_DGPortRef ref, void * buffer, unsigned int offset, unsigned int count, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setArrayDataRange(FECS_DGPortRef ref, void * buffer, unsigned int offset, unsigned int count, unsigned int slice);
+FECS_DECL bool FECS_DGPort_gatherArrayData(FECS_DGPortRef ref, const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_scatterArrayData(FECS_DGPortRef ref, const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getArrayDataStrided(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int stride, unsigned int offset, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setArrayDataStrided(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int count, unsigned int stride, unsigned int offset, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getArrayField(FECS_DGPortRef ref, const char * field, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setArrayField(FECS_DGPortRef ref, const char * field, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getArrayDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setArrayDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format, unsigned int slice);
 FECS_DECL bool FECS_DGPort_getAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize);
+FECS_DECL bool FECS_DGPort_checkSliceDataSize(FECS_DGPortRef ref, unsigned int dataSize);
+FECS_DECL bool FECS_DGPort_getSliceData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setSliceData(FECS_DGPortRef ref, const void * buffer, unsigned int bufferSize, unsigned int slice);
 FECS_DECL bool FECS_DGPort_setAllSlicesData(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize);
+FECS_DECL bool FECS_DGPort_getAllSlicesArrayData(FECS_DGPortRef ref, unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize);
+FECS_DECL bool FECS_DGPort_setAllSlicesArrayData(FECS_DGPortRef ref, const unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize);
+FECS_DECL bool FECS_DGPort_getStringData(FECS_DGPortRef ref, unsigned int * offsets, unsigned int offsetsCount, char * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setStringData(FECS_DGPortRef ref, const unsigned int * offsets, unsigned int offsetsCount, const char * buffer, unsigned int bufferSize, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getAllSlicesDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format);
+FECS_DECL bool FECS_DGPort_setAllSlicesDataConverted(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_DataFormat format);
+FECS_DECL bool FECS_DGPort_getArrayDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setArrayDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format, unsigned int slice);
+FECS_DECL bool FECS_DGPort_getAllSlicesDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format);
+FECS_DECL bool FECS_DGPort_setAllSlicesDataMatrices(FECS_DGPortRef ref, void * buffer, unsigned int bufferSize, FECS_MatrixOrder order, FECS_DataFormat format);
 FECS_DECL bool FECS_DGPort_copyArrayDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef otherRef, unsigned int slice, unsigned int otherSlice);
 FECS_DECL bool FECS_DGPort_copyAllSlicesDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef otherRef, bool resizeTarget);
+FECS_DECL bool FECS_DGPort_copyAllSlicesArrayDataFromPort(FECS_DGPortRef ref, FECS_DGPortRef otherRef, bool resizeTarget);
+FECS_DECL void * FECS_DGPort_acquireArrayDataCopy(FECS_DGPortRef ref, unsigned int * count, bool writable, unsigned int slice);
+FECS_DECL bool FECS_DGPort_releaseArrayDataCopy(FECS_DGPortRef ref);
+FECS_DECL bool FECS_DGPort_hasArrayDataCopy(FECS_DGPortRef ref);
+FECS_DECL bool FECS_DGPort_bindExternalArrayData(FECS_DGPortRef ref, void * data, unsigned int count, FECS_ExternalArrayReleaseFunc releaseFunc, void * userData, unsigned int slice);
+FECS_DECL bool FECS_DGPort_invalidateExternalArrayData(FECS_DGPortRef ref, unsigned int slice);
+FECS_DECL bool FECS_DGPort_unbindExternalArrayData(FECS_DGPortRef ref, unsigned int slice);
+FECS_DECL bool FECS_DGPort_isExternalArrayDataBound(FECS_DGPortRef ref, unsigned int slice);
+FECS_DECL void FECS_DGPort_getColumnSchema(FECS_DGPortRef ref, FabricCore::Variant & result);
+FECS_DECL bool FECS_DGPort_getColumnData(FECS_DGPortRef ref, FECS_ColumnData * columns, unsigned int columnCount, unsigned int slice);
+FECS_DECL bool FECS_DGPort_setColumnData(FECS_DGPortRef ref, const FECS_ColumnData * columns, unsigned int columnCount, unsigned int count, unsigned int slice);
 FECS_DECL void FECS_DGPort_setOption(FECS_DGPortRef ref, const char * name, const FabricCore::Variant & value);
 FECS_DECL void FECS_DGPort_getOption(FECS_DGPortRef ref, const char * name, FabricCore::Variant & result);
+FECS_DECL FECS_DGPortIOPlanRef FECS_DGPortIOPlan_construct();
+FECS_DECL FECS_DGPortIOPlanRef FECS_DGPortIOPlan_copy(FECS_DGPortIOPlanRef ref);
+FECS_DECL void FECS_DGPortIOPlan_destroy(FECS_DGPortIOPlanRef ref);
+FECS_DECL bool FECS_DGPortIOPlan_addEntry(FECS_DGPortIOPlanRef ref, FECS_DGPortRef portRef, void * buffer, unsigned int bufferSize, unsigned int slice, FECS_DGPort_Mode mode);
+FECS_DECL bool FECS_DGPortIOPlan_setEntryBuffer(FECS_DGPortIOPlanRef ref, unsigned int index, void * buffer, unsigned int bufferSize);
+FECS_DECL unsigned int FECS_DGPortIOPlan_getEntryCount(FECS_DGPortIOPlanRef ref);
+FECS_DECL void FECS_DGPortIOPlan_clear(FECS_DGPortIOPlanRef ref);
+FECS_DECL bool FECS_DGPortIOPlan_validate(FECS_DGPortIOPlanRef ref);
+FECS_DECL bool FECS_DGPortIOPlan_isValidated(FECS_DGPortIOPlanRef ref);
+FECS_DECL bool FECS_DGPortIOPlan_execute(FECS_DGPortIOPlanRef ref);
+
+FECS_DECL FECS_DGEvaluationRef FECS_DGEvaluation_copy(FECS_DGEvaluationRef ref);
+FECS_DECL void FECS_DGEvaluation_destroy(FECS_DGEvaluationRef ref);
+FECS_DECL char const * FECS_DGEvaluation_getGraphName(FECS_DGEvaluationRef ref);
+FECS_DECL FECS_DGEvaluation_State FECS_DGEvaluation_getState(FECS_DGEvaluationRef ref);
+FECS_DECL bool FECS_DGEvaluation_isDone(FECS_DGEvaluationRef ref);
+FECS_DECL bool FECS_DGEvaluation_wait(FECS_DGEvaluationRef ref);
+FECS_DECL void FECS_DGEvaluation_cancel(FECS_DGEvaluationRef ref);
 // FECS_DECL bool FECS_DGPort_isManipulatable(FECS_DGPortRef ref);
 // FECS_DECL void FECS_DGPort_getAnimationChannels(FECS_DGPortRef ref, FabricCore::RTVal & result);
 // FECS_DECL void FECS_DGPort_setAnimationChannelValues(FECS_DGPortRef ref, unsigned int nbChannels, float * values);
@@ -2043,6 +2522,12 @@ namespace FabricSplice
   // a function to be called when slow operations start or finish
   typedef FECS_SlowOperationFunc SlowOperationFunc;
 
+  // a function called once a DGPort no longer references a bound external buffer
+  typedef FECS_ExternalArrayReleaseFunc ExternalArrayReleaseFunc;
+
+  // a function called once an asynchronous evaluation is done, on the background thread
+  typedef FECS_DGEvaluationFunc DGEvaluationFunc;
+
   // a data set providing all manipulation data
   // typedef FECS_ManipulationData ManipulationData;
 
@@ -2052,9 +2537,14 @@ namespace FabricSplice
   // a data set providing all manipulation data
   typedef FECS_PersistenceInfo PersistenceInfo;
 
+  // the host buffers of a single column for the columnar IO
+  typedef FECS_ColumnData ColumnData;
+
   // forward declarations
   class DGGraph;
   class DGPort;
+  class DGPortIOPlan;
+  class DGEvaluation;
 
   enum Port_Mode
   {
@@ -2063,6 +2553,28 @@ namespace FabricSplice
     Port_Mode_IO = FECS_DGPort_Mode_IO
   };
 
+  enum DataFormat
+  {
+    DataFormat_Float32 = FECS_DataFormat_Float32,
+    DataFormat_Float64 = FECS_DataFormat_Float64,
+    DataFormat_Float16 = FECS_DataFormat_Float16
+  };
+
+  enum MatrixOrder
+  {
+    MatrixOrder_RowMajor = FECS_MatrixOrder_RowMajor,
+    MatrixOrder_ColumnMajor = FECS_MatrixOrder_ColumnMajor
+  };
+
+  enum DGEvaluation_State
+  {
+    DGEvaluation_State_Pending = FECS_DGEvaluation_State_Pending,
+    DGEvaluation_State_Running = FECS_DGEvaluation_State_Running,
+    DGEvaluation_State_Succeeded = FECS_DGEvaluation_State_Succeeded,
+    DGEvaluation_State_Failed = FECS_DGEvaluation_State_Failed,
+    DGEvaluation_State_Cancelled = FECS_DGEvaluation_State_Cancelled
+  };
+
   typedef FECS_LockType LockType;
   static const LockType LockType_Shared = FEC_LockType_Shared;
   static const LockType LockType_Exclusive = FEC_LockType_Exclusive;
@@ -2192,6 +2704,18 @@ namespace FabricSplice
     Exception::MaybeThrow();
   }
 
+  // enables the parallel copy for large array transfers on Ports. copies of at
+  // least threshold bytes are split across threadCount host threads (0 uses the
+  // number of hardware threads). nonTemporal uses streaming stores, which avoids
+  // evicting the cache for multi-GB transfers. this only applies to copies into
+  // host buffers, f.e. Port::getArrayDataRange. FabricCore copies into and out of
+  // the member itself, so getArrayData / setArrayData aren't affected.
+  inline void SetParallelCopy(bool enabled, unsigned int threadCount = 0, uint64_t threshold = 16777216, bool nonTemporal = false)
+  {
+    FECS_setParallelCopy(enabled, threadCount, threshold, nonTemporal);
+    Exception::MaybeThrow();
+  }
+
   // creates a RTVal just given a KL type name
   inline FabricCore::RTVal constructRTVal(const char * rt)
   {
@@ -3623,6 +4147,7 @@ namespace FabricSplice
   class DGPort
   {
     friend class DGGraph;
+    friend class DGPortIOPlan;
     friend class SceneManagement;
 
   public:
@@ -3835,6 +4360,42 @@ namespace FabricSplice
       return result;
     }
 
+    // sets the given keys of a struct or KL Dict value of a specific slice from
+    // a FabricCore::Variant dictionary. keys which aren't part of values are left
+    // untouched, the graph is never evaluated.
+    bool setDictValues(const FabricCore::Variant & values, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setDictValues(mRef, values, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // removes a key from a KL Dict value of a specific slice
+    bool removeDictValue(const char * key, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_removeDictValue(mRef, key, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the values of count slices starting at start as a FabricCore::Variant array
+    FabricCore::Variant getVariants(unsigned int start, unsigned int count)
+    {
+      FabricCore::Variant result;
+      FECS_DGPort_getVariants(mRef, start, count, result);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets all slices of this DGPort from a FabricCore::Variant array,
+    // resizing the FabricCore::DGNode to the size of the array.
+    bool setAllSlicesFromVariantArray(const FabricCore::Variant & values)
+    {
+      bool result = FECS_DGPort_setAllSlicesFromVariantArray(mRef, values);
+      Exception::MaybeThrow();
+      return result;
+    }
+
     // returns the value of a specific slice of this DGPort as a FabricCore::RTVal
     FabricCore::RTVal getRTVal(bool evaluate = false, uint32_t slice = 0)
     {
@@ -3844,6 +4405,15 @@ namespace FabricSplice
       return result;
     }
 
+    // returns the values of count slices starting at start as FabricCore::RTVals
+    // the results pointer has to provide room for count RTVals
+    bool getRTVals(FabricCore::RTVal * results, unsigned int start, unsigned int count, bool evaluate = false)
+    {
+      bool result = FECS_DGPort_getRTVals(mRef, results, start, count, evaluate);
+      Exception::MaybeThrow();
+      return result;
+    }
+
     // sets the value of a specific slice of this DGPort from a FabricCore::RTVal
     bool setRTVal(FabricCore::RTVal value, uint32_t slice = 0)
     {
@@ -3919,73 +4489,489 @@ namespace FabricSplice
       return result;
     }
 
-    // gets the void* slice array data of this DGPort.
-    // this only works for non-array Ports (isArray() == false)
-    // the bufferSize has to match getSliceCount() * getDataSize()
-    bool getAllSlicesData(void * buffer, unsigned int bufferSize)
+    // returns count elements of the array data of this DGPort starting at offset.
+    // this only works for array Ports (isArray() == true)
+    bool getArrayDataRange(void * buffer, unsigned int offset, unsigned int count, unsigned int slice = 0)
     {
-      bool result = FECS_DGPort_getAllSlicesData(mRef, buffer, bufferSize);
+      bool result = FECS_DGPort_getArrayDataRange(mRef, buffer, offset, count, slice);
       Exception::MaybeThrow();
       return result;
     }
 
-    // sets the void* slice array data of this DGPort.
-    // this only works for non-array Ports (isArray() == false)
-    // the bufferSize has to match getSliceCount() * getDataSize()
-    bool setAllSlicesData(void * buffer, unsigned int bufferSize)
+    // sets count elements of the array data of this DGPort starting at offset.
+    // the array is not resized, offset + count has to be within getArrayCount().
+    // FabricCore only writes whole arrays, so this still copies the entire array.
+    bool setArrayDataRange(void * buffer, unsigned int offset, unsigned int count, unsigned int slice = 0)
     {
-      bool result = FECS_DGPort_setAllSlicesData(mRef, buffer, bufferSize);
+      bool result = FECS_DGPort_setArrayDataRange(mRef, buffer, offset, count, slice);
       Exception::MaybeThrow();
       return result;
     }
 
-    // set the array data based on another port
-    // this performs data replication, and only works on shallow array data ports.
-    // the data type has to match as well (so only Vec3 to Vec3 for example).
-    bool copyArrayDataFromDGPort(DGPort other, unsigned int slice = 0, unsigned int otherSlice = UINT_MAX)
+    // returns the array elements at the given indices into a tightly packed buffer.
+    // this only works for array Ports (isArray() == true)
+    bool gatherArrayData(const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice = 0)
     {
-      bool result = FECS_DGPort_copyArrayDataFromPort(mRef, other.mRef, slice, otherSlice);
+      bool result = FECS_DGPort_gatherArrayData(mRef, indices, indexCount, buffer, bufferSize, slice);
       Exception::MaybeThrow();
       return result;
     }
 
-    // set the slices data based on another port
-    // this performs data replication, and only works on shallow non array data ports.
-    // the data type has to match as well (so only Vec3 to Vec3 for example).
-    bool copyAllSlicesDataFromDGPort(DGPort other, bool resizeTarget = false)
+    // sets the array elements at the given indices from a tightly packed buffer.
+    // the array is not resized, for duplicate indices the last element wins.
+    // FabricCore only writes whole arrays, so this still copies the entire array.
+    bool scatterArrayData(const unsigned int * indices, unsigned int indexCount, void * buffer, unsigned int bufferSize, unsigned int slice = 0)
     {
-      bool result = FECS_DGPort_copyAllSlicesDataFromPort(mRef, other.mRef, resizeTarget);
+      bool result = FECS_DGPort_scatterArrayData(mRef, indices, indexCount, buffer, bufferSize, slice);
       Exception::MaybeThrow();
       return result;
     }
 
-    // sets an auxiliary option
-    void setOption(const char * name, const FabricCore::Variant & value)
+    // returns the array data of this DGPort into a strided buffer.
+    // element i is written to buffer + offset + i * stride, a stride of 0 means tightly packed.
+    // this only works for array Ports (isArray() == true)
+    bool getArrayDataStrided(void * buffer, unsigned int bufferSize, unsigned int stride, unsigned int offset = 0, unsigned int slice = 0)
     {
-      FECS_DGPort_setOption(mRef, name, value);
+      bool result = FECS_DGPort_getArrayDataStrided(mRef, buffer, bufferSize, stride, offset, slice);
       Exception::MaybeThrow();
+      return result;
     }
 
-    // gets an auxiliary option (-1 if not defined)
-    FabricCore::Variant getOption(const char * name)
+    // sets the array data of this DGPort from a strided buffer.
+    // element i is read from buffer + offset + i * stride, a stride of 0 means tightly packed.
+    // this only works for array Ports (isArray() == true)
+    bool setArrayDataStrided(void * buffer, unsigned int bufferSize, unsigned int count, unsigned int stride, unsigned int offset = 0, unsigned int slice = 0)
     {
-      FabricCore::Variant option;
-      FECS_DGPort_getOption(mRef, name, option);
+      bool result = FECS_DGPort_setArrayDataStrided(mRef, buffer, bufferSize, count, stride, offset, slice);
       Exception::MaybeThrow();
-      return option;
+      return result;
     }
 
-    // returns true if an auxiliary option exists
-    bool hasOption(const char * name)
+    // returns a single field of all array elements as a tightly packed buffer,
+    // f.e. only "tr" of an Xfo[] Port. nested fields are separated by a dot.
+    // this only works for shallow array Ports (isArray() == true)
+    bool getArrayField(const char * field, void * buffer, unsigned int bufferSize, unsigned int slice = 0)
     {
-      FabricCore::Variant option = getOption(name);
-      return !option.isNull();
+      bool result = FECS_DGPort_getArrayField(mRef, field, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
     }
 
-    // gets an auxiliary option as boolean
-    bool getBooleanOption(const char * name, bool defaultValue = false)
+    // sets a single field of all array elements from a tightly packed buffer,
+    // the other fields keep their values.
+    // this only works for shallow array Ports (isArray() == true)
+    bool setArrayField(const char * field, void * buffer, unsigned int bufferSize, unsigned int slice = 0)
     {
-      FabricCore::Variant option = getOption(name);
+      bool result = FECS_DGPort_setArrayField(mRef, field, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the array data of this DGPort converted into the given format.
+    // this only works for array Ports of Float32 based types (like Vec3 or Color)
+    bool getArrayDataConverted(void * buffer, unsigned int bufferSize, DataFormat format, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_getArrayDataConverted(mRef, buffer, bufferSize, (FECS_DataFormat)format, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the array data of this DGPort from a buffer of the given format.
+    // this only works for array Ports of Float32 based types (like Vec3 or Color)
+    bool setArrayDataConverted(void * buffer, unsigned int bufferSize, DataFormat format, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setArrayDataConverted(mRef, buffer, bufferSize, (FECS_DataFormat)format, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // gets the void* slice array data of this DGPort.
+    // this only works for non-array Ports (isArray() == false)
+    // the bufferSize has to match getSliceCount() * getDataSize()
+    bool getAllSlicesData(void * buffer, unsigned int bufferSize)
+    {
+      bool result = FECS_DGPort_getAllSlicesData(mRef, buffer, bufferSize);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the void* slice array data of this DGPort.
+    // this only works for non-array Ports (isArray() == false)
+    // the bufferSize has to match getSliceCount() * getDataSize()
+    bool setAllSlicesData(void * buffer, unsigned int bufferSize)
+    {
+      bool result = FECS_DGPort_setAllSlicesData(mRef, buffer, bufferSize);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // gets the void* data of a single slice of this DGPort, without any Variant.
+    // this only works for shallow non-array Ports (isArray() == false)
+    // the bufferSize has to match getDataSize()
+    // only single slice DGNodes are copied without allocating, with more
+    // than one slice the requested slice is read through an RTVal.
+    bool getSliceData(void * buffer, unsigned int bufferSize, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_getSliceData(mRef, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the void* data of a single slice of this DGPort, without any Variant.
+    // this only works for shallow non-array Ports (isArray() == false)
+    // the bufferSize has to match getDataSize()
+    // only single slice DGNodes are copied without allocating, with more
+    // than one slice the requested slice is written through an RTVal.
+    bool setSliceData(const void * buffer, unsigned int bufferSize, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setSliceData(mRef, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the value of a single slice as T, f.e. port.get<float>() for a Scalar Port.
+    // T has to match the memory layout of the data type, sizeof(T) is checked against getDataSize().
+    template<typename T>
+    T get(unsigned int slice = 0)
+    {
+      T value;
+      getSliceData(&value, sizeof(T), slice);
+      return value;
+    }
+
+    // sets the value of a single slice from T, f.e. port.set<float>(1.0f) for a Scalar Port.
+    // T has to match the memory layout of the data type, sizeof(T) is checked against getDataSize().
+    template<typename T>
+    bool set(const T & value, unsigned int slice = 0)
+    {
+      return setSliceData(&value, sizeof(T), slice);
+    }
+
+    // binds a shallow non-array port to the C++ type T, the data size is checked
+    // once on construction so a mismatch fails early. get / set go through
+    // getSliceData / setSliceData. the port has to outlive the accessor
+    template<typename T>
+    class SliceAccessor
+    {
+    public:
+      SliceAccessor(DGPort & port)
+      : mPort(port)
+      {
+        FECS_DGPort_checkSliceDataSize(mPort.mRef, sizeof(T));
+        Exception::MaybeThrow();
+      }
+
+      T get(unsigned int slice = 0)
+      {
+        T value;
+        FECS_DGPort_getSliceData(mPort.mRef, &value, sizeof(T), slice);
+        Exception::MaybeThrow();
+        return value;
+      }
+
+      bool set(const T & value, unsigned int slice = 0)
+      {
+        bool result = FECS_DGPort_setSliceData(mPort.mRef, &value, sizeof(T), slice);
+        Exception::MaybeThrow();
+        return result;
+      }
+
+    private:
+      DGPort & mPort;
+    };
+
+    // gets the array data of all slices of this DGPort as one concatenated buffer.
+    // this only works for array Ports (isArray() == true)
+    // offsets has to hold getSliceCount() + 1 entries, the elements of slice i
+    // end up at [offsets[i], offsets[i+1]) within the buffer. if the buffer is NULL
+    // only the offsets are returned, so that the buffer can be allocated.
+    bool getAllSlicesArrayData(unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize)
+    {
+      bool result = FECS_DGPort_getAllSlicesArrayData(mRef, offsets, offsetsCount, buffer, bufferSize);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the array data of all slices of this DGPort from one concatenated buffer.
+    // the slice count is set to offsetsCount - 1 and each slice's array is resized
+    // to offsets[i+1] - offsets[i] elements.
+    bool setAllSlicesArrayData(const unsigned int * offsets, unsigned int offsetsCount, void * buffer, unsigned int bufferSize)
+    {
+      bool result = FECS_DGPort_setAllSlicesArrayData(mRef, offsets, offsetsCount, buffer, bufferSize);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // gets the strings of this Port as one packed UTF-8 buffer, without terminators.
+    // this only works for String Ports, the strings are the array elements of the
+    // given slice for array Ports, or all slices otherwise.
+    // offsets has to hold the string count + 1 entries, string i ends up at
+    // [offsets[i], offsets[i+1]) within the buffer. if the buffer is NULL
+    // only the offsets are returned, so that the buffer can be allocated.
+    bool getStringData(unsigned int * offsets, unsigned int offsetsCount, char * buffer, unsigned int bufferSize, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_getStringData(mRef, offsets, offsetsCount, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the strings of this Port from one packed UTF-8 buffer.
+    // this only works for String Ports. for array Ports the array of the given
+    // slice is resized to offsetsCount - 1, otherwise the slice count is set to it.
+    // FabricCore has no flat access to KL strings, so both directions still cost one
+    // RTVal per string. this saves the Variants, not the per string calls.
+    bool setStringData(const unsigned int * offsets, unsigned int offsetsCount, const char * buffer, unsigned int bufferSize, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setStringData(mRef, offsets, offsetsCount, buffer, bufferSize, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // gets the slice array data of this DGPort converted into the given format.
+    // this only works for non-array Ports of Float32 based types (like Vec3 or Color)
+    bool getAllSlicesDataConverted(void * buffer, unsigned int bufferSize, DataFormat format)
+    {
+      bool result = FECS_DGPort_getAllSlicesDataConverted(mRef, buffer, bufferSize, (FECS_DataFormat)format);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the slice array data of this DGPort from a buffer of the given format.
+    // this only works for non-array Ports of Float32 based types (like Vec3 or Color)
+    bool setAllSlicesDataConverted(void * buffer, unsigned int bufferSize, DataFormat format)
+    {
+      bool result = FECS_DGPort_setAllSlicesDataConverted(mRef, buffer, bufferSize, (FECS_DataFormat)format);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the array data of a Mat44 or Xfo Port as 4x4 matrices of the given
+    // order and format, Xfos are converted into matrices like Xfo.toMat44().
+    // this only works for array Ports (isArray() == true)
+    bool getArrayDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_getArrayDataMatrices(mRef, buffer, bufferSize, (FECS_MatrixOrder)order, (FECS_DataFormat)format, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the array data of a Mat44 Port from 4x4 matrices of the given order and format.
+    // this only works for array Ports (isArray() == true)
+    bool setArrayDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setArrayDataMatrices(mRef, buffer, bufferSize, (FECS_MatrixOrder)order, (FECS_DataFormat)format, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // gets the slice array data of a Mat44 or Xfo Port as 4x4 matrices of the given order and format.
+    // this only works for non-array Ports (isArray() == false)
+    bool getAllSlicesDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format)
+    {
+      bool result = FECS_DGPort_getAllSlicesDataMatrices(mRef, buffer, bufferSize, (FECS_MatrixOrder)order, (FECS_DataFormat)format);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // sets the slice array data of a Mat44 Port from 4x4 matrices of the given order and format.
+    // this only works for non-array Ports (isArray() == false)
+    bool setAllSlicesDataMatrices(void * buffer, unsigned int bufferSize, MatrixOrder order, DataFormat format)
+    {
+      bool result = FECS_DGPort_setAllSlicesDataMatrices(mRef, buffer, bufferSize, (FECS_MatrixOrder)order, (FECS_DataFormat)format);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // set the array data based on another port
+    // this performs data replication, and only works on shallow array data ports.
+    // the data type has to match as well (so only Vec3 to Vec3 for example).
+    bool copyArrayDataFromDGPort(DGPort other, unsigned int slice = 0, unsigned int otherSlice = UINT_MAX)
+    {
+      bool result = FECS_DGPort_copyArrayDataFromPort(mRef, other.mRef, slice, otherSlice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // set the slices data based on another port
+    // this performs data replication, and only works on shallow non array data ports.
+    // the data type has to match as well (so only Vec3 to Vec3 for example).
+    bool copyAllSlicesDataFromDGPort(DGPort other, bool resizeTarget = false)
+    {
+      bool result = FECS_DGPort_copyAllSlicesDataFromPort(mRef, other.mRef, resizeTarget);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // set the array data of all slices based on another port
+    // this performs data replication, and only works on shallow array data ports.
+    // the data type has to match as well (so only Vec3 to Vec3 for example).
+    bool copyAllSlicesArrayDataFromDGPort(DGPort other, bool resizeTarget = false)
+    {
+      bool result = FECS_DGPort_copyAllSlicesArrayDataFromPort(mRef, other.mRef, resizeTarget);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // copies the array data of a slice into a buffer owned by the Port and returns it.
+    // this only works for shallow array Ports (isArray() == true).
+    // this is a copy-in/copy-out convenience costing the same copies as getArrayData and
+    // setArrayData. writable copies are copied back into the member and dirty the graph
+    // on releaseArrayDataCopy(), a copy left on destruction is dropped.
+    void * acquireArrayDataCopy(unsigned int & count, bool writable = false, unsigned int slice = 0)
+    {
+      void * result = FECS_DGPort_acquireArrayDataCopy(mRef, &count, writable, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // releases the copy acquired by acquireArrayDataCopy
+    bool releaseArrayDataCopy()
+    {
+      bool result = FECS_DGPort_releaseArrayDataCopy(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns true if this DGPort currently holds a copy of its array data
+    bool hasArrayDataCopy()
+    {
+      bool result = FECS_DGPort_hasArrayDataCopy(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // binds a host owned buffer of count elements as the array data of a slice.
+    // this only works for shallow array Ports (isArray() == true) which aren't outputs.
+    // the buffer is read directly into the member right before the next evaluation,
+    // so the host has to keep it alive until releaseFunc is called. binding a new
+    // buffer (f.e. after the host reallocated) releases the previous one.
+    bool bindExternalArrayData(void * data, unsigned int count, ExternalArrayReleaseFunc releaseFunc = NULL, void * userData = NULL, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_bindExternalArrayData(mRef, data, count, releaseFunc, userData, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // marks the bound external buffer of a slice as modified in place
+    bool invalidateExternalArrayData(unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_invalidateExternalArrayData(mRef, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // removes the external buffer binding of a slice and releases the buffer
+    bool unbindExternalArrayData(unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_unbindExternalArrayData(mRef, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns true if an external buffer is bound to the given slice
+    bool isExternalArrayDataBound(unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_isExternalArrayDataBound(mRef, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the columns the data type of this Port is flattened into, as an array
+    // of dicts with the keys 'path', 'dataType', 'elementSize' and 'variable'.
+    // this works for struct and object Ports, shallow or not. members which can't be
+    // flattened (dictionaries, interfaces, arrays of non shallow types) are left out.
+    FabricCore::Variant getColumnSchema()
+    {
+      FabricCore::Variant result;
+      FECS_DGPort_getColumnSchema(mRef, result);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // reads the given columns of all elements into flat buffers. the elements are the
+    // array elements of the given slice for array Ports, or all slices otherwise.
+    // variable columns (Strings and arrays) use element count + 1 offsets into data,
+    // counted in column elements. without data only the offsets are filled in.
+    bool getColumnData(ColumnData * columns, unsigned int columnCount, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_getColumnData(mRef, columns, columnCount, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // writes the given columns of count elements from flat buffers. this resizes
+    // the array of the given slice for array Ports, or sets the slice count otherwise.
+    // columns which aren't provided keep their values, null objects are constructed.
+    // the elements are accessed one by one as RTVals, and for array Ports the whole
+    // array is copied back into the member, so this isn't a bulk copy like setArrayData.
+    bool setColumnData(const ColumnData * columns, unsigned int columnCount, unsigned int count, unsigned int slice = 0)
+    {
+      bool result = FECS_DGPort_setColumnData(mRef, columns, columnCount, count, slice);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // holds a copy of the array data of a port for the lifetime of this object,
+    // the port has to outlive the copy
+    class AutoArrayDataCopy
+    {
+    public:
+      AutoArrayDataCopy(DGPort & port, bool writable = false, unsigned int slice = 0)
+      : mPort(port)
+      {
+        mCount = 0;
+        mData = mPort.acquireArrayDataCopy(mCount, writable, slice);
+      }
+
+      ~AutoArrayDataCopy()
+      {
+        // don't throw from the destructor, errors are available through Logging
+        FECS_DGPort_releaseArrayDataCopy(mPort.mRef);
+      }
+
+      void * getData()
+      {
+        return mData;
+      }
+
+      unsigned int getCount() const
+      {
+        return mCount;
+      }
+
+    private:
+      DGPort & mPort;
+      void * mData;
+      unsigned int mCount;
+    };
+
+    // sets an auxiliary option
+    void setOption(const char * name, const FabricCore::Variant & value)
+    {
+      FECS_DGPort_setOption(mRef, name, value);
+      Exception::MaybeThrow();
+    }
+
+    // gets an auxiliary option (-1 if not defined)
+    FabricCore::Variant getOption(const char * name)
+    {
+      FabricCore::Variant option;
+      FECS_DGPort_getOption(mRef, name, option);
+      Exception::MaybeThrow();
+      return option;
+    }
+
+    // returns true if an auxiliary option exists
+    bool hasOption(const char * name)
+    {
+      FabricCore::Variant option = getOption(name);
+      return !option.isNull();
+    }
+
+    // gets an auxiliary option as boolean
+    bool getBooleanOption(const char * name, bool defaultValue = false)
+    {
+      FabricCore::Variant option = getOption(name);
       if(!option.isBoolean())
         return getIntegerOption(name, defaultValue) != 0;
       return option.getBoolean();
@@ -4098,6 +5084,204 @@ namespace FabricSplice
     FECS_DGPortRef mRef;
   };
 
+  class DGPortIOPlan
+  {
+  public:
+
+    DGPortIOPlan()
+    {
+      mRef = FECS_DGPortIOPlan_construct();
+      Exception::MaybeThrow();
+    }
+
+    DGPortIOPlan(DGPortIOPlan const & other)
+    {
+      mRef = FECS_DGPortIOPlan_copy(other.mRef);
+      Exception::MaybeThrow();
+    }
+
+    DGPortIOPlan & operator =( DGPortIOPlan const & other )
+    {
+      FECS_DGPortIOPlan_destroy(mRef);
+      mRef = FECS_DGPortIOPlan_copy(other.mRef);
+      Exception::MaybeThrow();
+      return *this;
+    }
+
+    ~DGPortIOPlan()
+    {
+      FECS_DGPortIOPlan_destroy(mRef);
+      Exception::MaybeThrow();
+    }
+
+    // returns true if the object is valid
+    bool isValid() const
+    {
+      return mRef != NULL;
+    }
+
+    // bool conversion operator
+    // returning bool_type prevents the automatic
+    // conversion to int
+    operator explicit_bool::type() const
+    {
+      return explicit_bool::get(isValid());
+    }
+
+    // adds an entry. mode has to be Port_Mode_IN (buffer to port)
+    // or Port_Mode_OUT (port to buffer). for array ports the buffer covers
+    // the array of the slice, for non-array ports it covers all slices.
+    bool addEntry(DGPort port, void * buffer, unsigned int bufferSize, unsigned int slice = 0, Port_Mode mode = Port_Mode_IN)
+    {
+      bool result = FECS_DGPortIOPlan_addEntry(mRef, port.mRef, buffer, bufferSize, slice, (FECS_DGPort_Mode)mode);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // changes the buffer of an existing entry without invalidating the plan
+    bool setEntryBuffer(unsigned int index, void * buffer, unsigned int bufferSize)
+    {
+      bool result = FECS_DGPortIOPlan_setEntryBuffer(mRef, index, buffer, bufferSize);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the number of entries
+    unsigned int getEntryCount()
+    {
+      unsigned int result = FECS_DGPortIOPlan_getEntryCount(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // removes all entries
+    void clear()
+    {
+      FECS_DGPortIOPlan_clear(mRef);
+      Exception::MaybeThrow();
+    }
+
+    // performs all checks for all entries once
+    bool validate()
+    {
+      bool result = FECS_DGPortIOPlan_validate(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns true if the plan has been validated since the last change
+    bool isValidated()
+    {
+      bool result = FECS_DGPortIOPlan_isValidated(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // writes all inputs, evaluates once and reads all outputs
+    bool execute()
+    {
+      bool result = FECS_DGPortIOPlan_execute(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+  private:
+    FECS_DGPortIOPlanRef mRef;
+  };
+
+  class DGEvaluation
+  {
+    friend class DGGraph;
+
+  public:
+
+    DGEvaluation()
+    {
+      mRef = NULL;
+    }
+
+    DGEvaluation(DGEvaluation const & other)
+    {
+      mRef = FECS_DGEvaluation_copy(other.mRef);
+      Exception::MaybeThrow();
+    }
+
+    DGEvaluation & operator =( DGEvaluation const & other )
+    {
+      FECS_DGEvaluation_destroy(mRef);
+      mRef = FECS_DGEvaluation_copy(other.mRef);
+      Exception::MaybeThrow();
+      return *this;
+    }
+
+    ~DGEvaluation()
+    {
+      FECS_DGEvaluation_destroy(mRef);
+      Exception::MaybeThrow();
+    }
+
+    // returns true if the object is valid
+    bool isValid() const
+    {
+      return mRef != NULL;
+    }
+
+    // bool conversion operator
+    // returning bool_type prevents the automatic
+    // conversion to int
+    operator explicit_bool::type() const
+    {
+      return explicit_bool::get(isValid());
+    }
+
+    // returns the name of the evaluated graph
+    char const * getGraphName()
+    {
+      char const * result = FECS_DGEvaluation_getGraphName(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns the current state
+    DGEvaluation_State getState()
+    {
+      DGEvaluation_State result = (DGEvaluation_State)FECS_DGEvaluation_getState(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // returns true if the evaluation succeeded, failed or has been cancelled
+    bool isDone()
+    {
+      bool result = FECS_DGEvaluation_isDone(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // blocks until the evaluation is done, returns true if it succeeded
+    bool wait()
+    {
+      bool result = FECS_DGEvaluation_wait(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // cancels the evaluation without waiting for it. a pending evaluation
+    // doesn't start, a running one stops after the current level.
+    void cancel()
+    {
+      FECS_DGEvaluation_cancel(mRef);
+      Exception::MaybeThrow();
+    }
+
+  private:
+    DGEvaluation(FECS_DGEvaluationRef ref)
+    {
+      mRef = ref;
+    }
+    FECS_DGEvaluationRef mRef;
+  };
+
   class DGGraph
   {
   public:
@@ -4436,7 +5620,9 @@ namespace FabricSplice
       Exception::MaybeThrow();
     }
 
-    // evaluates the contained DGNode
+    // evaluates the contained DGNodes. if the graph evaluates shared (see setEvaluateShared),
+    // DGNodes without a dependency path between them are evaluated in parallel, otherwise
+    // they are evaluated one after the other
     bool evaluate()
     {
       bool result = FECS_DGGraph_evaluate(mRef);
@@ -4444,6 +5630,56 @@ namespace FabricSplice
       return result;
     }
 
+    // evaluates the dirty DGNodes of several DGGraphs in dependency order, checking
+    // for errors only once. if parallel is true the graphs evaluating shared are spread
+    // across the host thread pool (see SetParallelCopy for the thread count), the others
+    // are evaluated one after the other on the calling thread. results receives the
+    // status of each graph, a graph listed more than once is evaluated once and shares
+    // its result.
+    static bool evaluateAll(DGGraph * graphs, unsigned int count, bool parallel = true, bool * results = NULL)
+    {
+      std::vector<FECS_DGGraphRef> refs(count);
+      for(unsigned int i=0;i<count;i++)
+        refs[i] = graphs[i].mRef;
+      bool result = FECS_DGGraph_evaluateAll(count > 0 ? &refs[0] : NULL, count, parallel, results);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // evaluates the dirty DGNodes on a background thread and returns the handle of the
+    // evaluation, func is called once it is done. a new evaluation supersedes the one in
+    // flight. while an evaluation is in flight, reading a DGPort waits for it to finish,
+    // writing a DGPort or changing the graph cancels it first.
+    DGEvaluation evaluateAsync(DGEvaluationFunc func = NULL, void * userData = NULL)
+    {
+      FECS_DGEvaluationRef ref = FECS_DGGraph_evaluateAsync(mRef, func, userData);
+      Exception::MaybeThrow();
+      return DGEvaluation(ref);
+    }
+
+    // returns true if an asynchronous evaluation is in flight
+    bool isEvaluating()
+    {
+      bool result = FECS_DGGraph_isEvaluating(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // waits for the asynchronous evaluation in flight, returns false if it failed
+    bool waitForEvaluation()
+    {
+      bool result = FECS_DGGraph_waitForEvaluation(mRef);
+      Exception::MaybeThrow();
+      return result;
+    }
+
+    // cancels the asynchronous evaluation in flight and waits for it to stop
+    void cancelEvaluation()
+    {
+      FECS_DGGraph_cancelEvaluation(mRef);
+      Exception::MaybeThrow();
+    }
+
     // clears the evaluate state
     bool clearEvaluate()
     {
@@ -0,0 +1,601 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "JSONCodecImpl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+
+using namespace FabricSpliceImpl;
+
+std::map<std::string, JSONCodecImpl::ProgramPtr> JSONCodecImpl::sPrograms;
+boost::mutex JSONCodecImpl::sProgramsMutex;
+
+// splits a leaf path into its components, "m[1].x" becomes "m", "[1]", "x"
+static void splitLeafPath(const std::string & path, stringVector & components)
+{
+  size_t start = 0;
+  for(size_t i=0;i<=path.length();i++)
+  {
+    if(i < path.length() && path[i] != '.' && path[i] != '[')
+      continue;
+    if(i > start)
+      components.push_back(path.substr(start, i - start));
+    start = (i < path.length() && path[i] == '.') ? i + 1 : i;
+  }
+}
+
+// sprintf and strtod follow the locale of the host application, which might
+// use a decimal comma. JSON always uses a dot, so the separator is swapped.
+static char getLocaleDecimalPoint()
+{
+  const char * point = localeconv()->decimal_point;
+  if(point == NULL || point[0] == 0)
+    return '.';
+  return point[0];
+}
+
+static void formatReal(char * buffer, int precision, double value, char decimalPoint)
+{
+  sprintf(buffer, "%.*g", precision, value);
+  if(decimalPoint != '.')
+  {
+    char * point = strchr(buffer, decimalPoint);
+    if(point)
+      *point = '.';
+  }
+}
+
+// parses a JSON number starting at p, end receives the first character after it
+static double parseReal(const char * p, const char ** end)
+{
+  const char * start = p;
+  if(*p == '-')
+    p++;
+  while(*p >= '0' && *p <= '9')
+    p++;
+  const char * point = NULL;
+  if(*p == '.')
+  {
+    point = p++;
+    while(*p >= '0' && *p <= '9')
+      p++;
+  }
+  if(*p == 'e' || *p == 'E')
+  {
+    p++;
+    if(*p == '+' || *p == '-')
+      p++;
+    while(*p >= '0' && *p <= '9')
+      p++;
+  }
+  *end = p;
+
+  char decimalPoint = getLocaleDecimalPoint();
+  if(point == NULL || decimalPoint == '.')
+    return strtod(start, NULL);
+
+  std::string number(start, p - start);
+  number[point - start] = decimalPoint;
+  return strtod(number.c_str(), NULL);
+}
+
+// the state of a single decode call
+struct JSONDecodeState
+{
+  const char * json;
+  const char * p;
+  TypeLayoutImplPtr layout;
+  std::string path;
+  uint32_t nextLeaf;
+  std::string * errorOut;
+
+  void skipWhitespace()
+  {
+    while(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+      p++;
+  }
+
+  bool fail(const std::string & message)
+  {
+    char offsetStr[32];
+    sprintf(offsetStr, "%u", (unsigned int)(p - json));
+    return LoggingImpl::reportError("Invalid JSON at offset "+std::string(offsetStr)+": "+message, errorOut);
+  }
+
+  bool matchLiteral(const char * literal)
+  {
+    size_t length = strlen(literal);
+    if(strncmp(p, literal, length) != 0)
+      return false;
+    p += length;
+    return true;
+  }
+};
+
+static bool decodeKey(JSONDecodeState & state, std::string & key)
+{
+  if(*state.p != '"')
+    return state.fail("Expected a key.");
+  state.p++;
+  key.clear();
+  while(*state.p != '"')
+  {
+    if(*state.p == 0)
+      return state.fail("Unterminated string.");
+    if(*state.p == '\\')
+    {
+      state.p++;
+      switch(*state.p)
+      {
+        case '"': case '\\': case '/': key += *state.p; break;
+        case 'b': key += '\b'; break;
+        case 'f': key += '\f'; break;
+        case 'n': key += '\n'; break;
+        case 'r': key += '\r'; break;
+        case 't': key += '\t'; break;
+        default:
+          return state.fail("Unsupported escape sequence.");
+      }
+      state.p++;
+      continue;
+    }
+    key += *state.p++;
+  }
+  state.p++;
+  return true;
+}
+
+template<typename T>
+static void storeLeaf(char * target, T value)
+{
+  memcpy(target, &value, sizeof(T));
+}
+
+static bool decodeScalar(JSONDecodeState & state, TypeLayoutImpl::LeafType type, char * target)
+{
+  bool isTrue = state.matchLiteral("true");
+  if(isTrue || state.matchLiteral("false"))
+  {
+    if(type != TypeLayoutImpl::LeafType_Boolean)
+      return state.fail("Expected a number.");
+    storeLeaf<uint8_t>(target, isTrue ? 1 : 0);
+    return true;
+  }
+  // integers are parsed by hand to keep the full 64 bit precision
+  const char * start = state.p;
+  bool negative = *state.p == '-';
+  if(negative)
+    state.p++;
+  uint64_t integer = 0;
+  const char * digits = state.p;
+  while(*state.p >= '0' && *state.p <= '9')
+    integer = integer * 10 + (uint64_t)(*state.p++ - '0');
+  if(state.p == digits)
+    return state.fail("Expected a number.");
+
+  bool isFloat = *state.p == '.' || *state.p == 'e' || *state.p == 'E';
+  double real = 0.0;
+  if(isFloat || type == TypeLayoutImpl::LeafType_Float32 || type == TypeLayoutImpl::LeafType_Float64)
+  {
+    real = parseReal(start, &state.p);
+    isFloat = true;
+  }
+  int64_t sinteger = negative ? -(int64_t)integer : (int64_t)integer;
+
+  switch(type)
+  {
+    case TypeLayoutImpl::LeafType_Boolean:
+      storeLeaf<uint8_t>(target, (isFloat ? real != 0.0 : integer != 0) ? 1 : 0);
+      break;
+    case TypeLayoutImpl::LeafType_UInt8:
+      storeLeaf<uint8_t>(target, isFloat ? (uint8_t)real : (uint8_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_SInt8:
+      storeLeaf<int8_t>(target, isFloat ? (int8_t)real : (int8_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_UInt16:
+      storeLeaf<uint16_t>(target, isFloat ? (uint16_t)real : (uint16_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_SInt16:
+      storeLeaf<int16_t>(target, isFloat ? (int16_t)real : (int16_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_UInt32:
+      storeLeaf<uint32_t>(target, isFloat ? (uint32_t)real : (uint32_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_SInt32:
+      storeLeaf<int32_t>(target, isFloat ? (int32_t)real : (int32_t)sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_UInt64:
+      storeLeaf<uint64_t>(target, isFloat ? (uint64_t)real : (negative ? (uint64_t)sinteger : integer));
+      break;
+    case TypeLayoutImpl::LeafType_SInt64:
+      storeLeaf<int64_t>(target, isFloat ? (int64_t)real : sinteger);
+      break;
+    case TypeLayoutImpl::LeafType_Float32:
+      storeLeaf<float>(target, (float)real);
+      break;
+    case TypeLayoutImpl::LeafType_Float64:
+      storeLeaf<double>(target, real);
+      break;
+  }
+  return true;
+}
+
+static bool decodeValue(JSONDecodeState & state, char * element)
+{
+  state.skipWhitespace();
+  size_t pathLength = state.path.length();
+
+  if(*state.p == '{')
+  {
+    state.p++;
+    state.skipWhitespace();
+    if(*state.p == '}')
+    {
+      state.p++;
+      return true;
+    }
+    std::string key;
+    while(true)
+    {
+      if(!decodeKey(state, key))
+        return false;
+      state.skipWhitespace();
+      if(*state.p != ':')
+        return state.fail("Expected ':'.");
+      state.p++;
+
+      if(pathLength > 0)
+        state.path += '.';
+      state.path += key;
+      if(!decodeValue(state, element))
+        return false;
+      state.path.resize(pathLength);
+
+      state.skipWhitespace();
+      if(*state.p == ',')
+      {
+        state.p++;
+        state.skipWhitespace();
+        continue;
+      }
+      if(*state.p != '}')
+        return state.fail("Expected ',' or '}'.");
+      state.p++;
+      return true;
+    }
+  }
+
+  if(*state.p == '[')
+  {
+    state.p++;
+    state.skipWhitespace();
+    if(*state.p == ']')
+    {
+      state.p++;
+      return true;
+    }
+    for(uint32_t index=0;;index++)
+    {
+      char indexStr[32];
+      sprintf(indexStr, "[%u]", index);
+      state.path += indexStr;
+      if(!decodeValue(state, element))
+        return false;
+      state.path.resize(pathLength);
+
+      state.skipWhitespace();
+      if(*state.p == ',')
+      {
+        state.p++;
+        continue;
+      }
+      if(*state.p != ']')
+        return state.fail("Expected ',' or ']'.");
+      state.p++;
+      return true;
+    }
+  }
+
+  // members are usually encoded in layout order, so the next
+  // leaf is tried before looking the path up
+  const TypeLayoutImplPtr & layout = state.layout;
+  int leafIndex = -1;
+  if(state.nextLeaf < layout->getLeafCount() && layout->getLeaf(state.nextLeaf).path == state.path)
+    leafIndex = (int)state.nextLeaf;
+  else
+    leafIndex = layout->getLeafIndex(state.path);
+  if(leafIndex < 0)
+    return state.fail("Type '"+std::string(layout->getDataType())+"' has no member '"+state.path+"'.");
+  state.nextLeaf = (uint32_t)leafIndex + 1;
+
+  const TypeLayoutImpl::Leaf & leaf = layout->getLeaf((uint32_t)leafIndex);
+  return decodeScalar(state, leaf.type, element + leaf.offset);
+}
+
+bool JSONCodecImpl::encode(
+  std::string & json,
+  TypeLayoutImplPtr layout,
+  const void * data,
+  uint32_t count,
+  bool isArray,
+  std::string * errorOut
+  )
+{
+  if(!layout)
+    return LoggingImpl::reportError("JSONCodecImpl::encode, no valid layout provided.", errorOut);
+  if(!isArray && count != 1)
+    return LoggingImpl::reportError("JSONCodecImpl::encode, a single element has to be provided.", errorOut);
+  if(data == NULL && count > 0)
+    return LoggingImpl::reportError("JSONCodecImpl::encode, no valid data provided.", errorOut);
+
+  ProgramPtr programPtr = getProgram(layout);
+  const Program & program = *programPtr;
+  uint32_t elementSize = layout->getSize();
+  const char * element = (const char*)data;
+  char decimalPoint = getLocaleDecimalPoint();
+
+  if(isArray)
+    json += '[';
+  for(uint32_t i=0;i<count;i++, element += elementSize)
+  {
+    if(i > 0)
+      json += ',';
+    for(size_t j=0;j<program.size();j++)
+    {
+      const Token & token = program[j];
+      json += token.literal;
+      if(token.leafIndex < 0)
+        continue;
+      const TypeLayoutImpl::Leaf & leaf = layout->getLeaf((uint32_t)token.leafIndex);
+      if(!appendLeaf(json, leaf.type, element + leaf.offset, decimalPoint))
+        return LoggingImpl::reportError("JSONCodecImpl::encode, NaN and infinity can't be represented in JSON.", errorOut);
+    }
+  }
+  if(isArray)
+    json += ']';
+  return true;
+}
+
+bool JSONCodecImpl::decode(
+  const char * json,
+  TypeLayoutImplPtr layout,
+  std::vector<char> & data,
+  bool isArray,
+  std::string * errorOut
+  )
+{
+  if(!layout)
+    return LoggingImpl::reportError("JSONCodecImpl::decode, no valid layout provided.", errorOut);
+  if(json == NULL)
+    return LoggingImpl::reportError("JSONCodecImpl::decode, no valid JSON provided.", errorOut);
+
+  uint32_t elementSize = layout->getSize();
+  if(!isArray && data.size() != elementSize)
+    return LoggingImpl::reportError("JSONCodecImpl::decode, the data size does not match the layout.", errorOut);
+
+  JSONDecodeState state;
+  state.json = json;
+  state.p = json;
+  state.layout = layout;
+  state.nextLeaf = 0;
+  state.errorOut = errorOut;
+  state.skipWhitespace();
+
+  if(isArray)
+  {
+    if(*state.p != '[')
+      return state.fail("Expected an array.");
+    state.p++;
+    state.skipWhitespace();
+
+    size_t count = 0;
+    if(*state.p == ']')
+      state.p++;
+    else
+    {
+      while(true)
+      {
+        if(data.size() < (count + 1) * elementSize)
+          data.resize((count + 1) * elementSize, 0);
+        state.nextLeaf = 0;
+        if(!decodeValue(state, &data[count * elementSize]))
+          return false;
+        count++;
+
+        state.skipWhitespace();
+        if(*state.p == ',')
+        {
+          state.p++;
+          continue;
+        }
+        if(*state.p != ']')
+          return state.fail("Expected ',' or ']'.");
+        state.p++;
+        break;
+      }
+    }
+    data.resize(count * elementSize);
+  }
+  else if(!decodeValue(state, &data[0]))
+    return false;
+
+  state.skipWhitespace();
+  if(*state.p != 0)
+    return state.fail("Unexpected trailing characters.");
+  return true;
+}
+
+void JSONCodecImpl::clearCache()
+{
+  boost::unique_lock<boost::mutex> lock(sProgramsMutex);
+  sPrograms.clear();
+}
+
+JSONCodecImpl::ProgramPtr JSONCodecImpl::getProgram(TypeLayoutImplPtr layout)
+{
+  boost::unique_lock<boost::mutex> lock(sProgramsMutex);
+  std::map<std::string, ProgramPtr>::iterator it = sPrograms.find(layout->getDataType());
+  if(it != sPrograms.end())
+    return it->second;
+
+  ProgramPtr program(new Program());
+  buildProgram(layout, *program);
+  sPrograms.insert(std::pair<std::string, ProgramPtr>(layout->getDataType(), program));
+  return program;
+}
+
+void JSONCodecImpl::buildProgram(TypeLayoutImplPtr layout, Program & program)
+{
+  // the structure of the type is flattened into a list of literals, each
+  // followed by a leaf. f.e. Vec3 becomes '{"x":' x ',"y":' y ',"z":' z '}'
+  Token token;
+  token.leafIndex = -1;
+
+  uint32_t leafCount = layout->getLeafCount();
+  if(leafCount == 1 && layout->getLeaf(0).path.length() == 0)
+  {
+    token.leafIndex = 0;
+    program.push_back(token);
+    return;
+  }
+
+  // open containers, true for arrays, and whether they already hold a value
+  std::vector<bool> isArrayStack;
+  std::vector<bool> hasValueStack;
+  stringVector prevChain;
+
+  for(uint32_t i=0;i<leafCount;i++)
+  {
+    stringVector components;
+    splitLeafPath(layout->getLeaf(i).path, components);
+    if(components.size() == 0)
+      continue;
+
+    if(isArrayStack.size() == 0)
+    {
+      isArrayStack.push_back(components[0][0] == '[');
+      hasValueStack.push_back(false);
+      token.literal += isArrayStack.back() ? '[' : '{';
+    }
+
+    stringVector chain(components.begin(), components.end() - 1);
+    size_t common = 0;
+    while(common < chain.size() && common < prevChain.size() && chain[common] == prevChain[common])
+      common++;
+
+    while(isArrayStack.size() > common + 1)
+    {
+      token.literal += isArrayStack.back() ? ']' : '}';
+      isArrayStack.pop_back();
+      hasValueStack.pop_back();
+    }
+
+    for(size_t j=common;j<components.size();j++)
+    {
+      if(hasValueStack.back())
+        token.literal += ',';
+      hasValueStack.back() = true;
+      if(components[j][0] != '[')
+        token.literal += "\"" + components[j] + "\":";
+      if(j + 1 == components.size())
+        break;
+
+      isArrayStack.push_back(components[j+1][0] == '[');
+      hasValueStack.push_back(false);
+      token.literal += isArrayStack.back() ? '[' : '{';
+    }
+
+    token.leafIndex = (int)i;
+    program.push_back(token);
+    token.literal.clear();
+    token.leafIndex = -1;
+    prevChain = chain;
+  }
+
+  while(isArrayStack.size() > 0)
+  {
+    token.literal += isArrayStack.back() ? ']' : '}';
+    isArrayStack.pop_back();
+  }
+  program.push_back(token);
+}
+
+template<typename T>
+static T loadLeaf(const char * data)
+{
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+bool JSONCodecImpl::appendLeaf(std::string & json, TypeLayoutImpl::LeafType type, const char * data, char decimalPoint)
+{
+  char buffer[64];
+  switch(type)
+  {
+    case TypeLayoutImpl::LeafType_Boolean:
+      json += loadLeaf<uint8_t>(data) ? "true" : "false";
+      return true;
+    case TypeLayoutImpl::LeafType_UInt8:
+      sprintf(buffer, "%u", (unsigned int)loadLeaf<uint8_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_SInt8:
+      sprintf(buffer, "%d", (int)loadLeaf<int8_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_UInt16:
+      sprintf(buffer, "%u", (unsigned int)loadLeaf<uint16_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_SInt16:
+      sprintf(buffer, "%d", (int)loadLeaf<int16_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_UInt32:
+      sprintf(buffer, "%u", loadLeaf<uint32_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_SInt32:
+      sprintf(buffer, "%d", loadLeaf<int32_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_UInt64:
+      sprintf(buffer, "%llu", (unsigned long long)loadLeaf<uint64_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_SInt64:
+      sprintf(buffer, "%lld", (long long)loadLeaf<int64_t>(data));
+      break;
+    case TypeLayoutImpl::LeafType_Float32:
+    {
+      // JSON has no representation for NaN or infinity
+      float value = loadLeaf<float>(data);
+      if(value != value || value - value != 0.0f)
+        return false;
+      // the shortest representation which reads back to the same value
+      for(int precision=6;precision<=9;precision++)
+      {
+        formatReal(buffer, precision, value, decimalPoint);
+        const char * end = NULL;
+        if((float)parseReal(buffer, &end) == value)
+          break;
+      }
+      break;
+    }
+    case TypeLayoutImpl::LeafType_Float64:
+    {
+      double value = loadLeaf<double>(data);
+      if(value != value || value - value != 0.0)
+        return false;
+      for(int precision=15;precision<=17;precision++)
+      {
+        formatReal(buffer, precision, value, decimalPoint);
+        const char * end = NULL;
+        if(parseReal(buffer, &end) == value)
+          break;
+      }
+      break;
+    }
+    default:
+      return true;
+  }
+  json += buffer;
+  return true;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_JSONCODECIMPL_H__
+#define __FabricSpliceImpl_JSONCODECIMPL_H__
+
+#include "TypeLayoutImpl.h"
+
+#include <boost/thread/mutex.hpp>
+
+namespace FabricSpliceImpl
+{
+  /// encodes and decodes JSON straight from / into the memory of shallow
+  /// types, driven by their TypeLayoutImpl. no FabricCore::Variant is
+  /// created on the way.
+  class JSONCodecImpl
+  {
+  public:
+
+    /// appends the JSON encoding of count elements to json.
+    /// if isArray is true the elements are encoded as a JSON array,
+    /// otherwise count has to be 1. fails for NaN and infinity, which have
+    /// no JSON representation. numbers are locale independent.
+    static bool encode(
+      std::string & json,
+      TypeLayoutImplPtr layout,
+      const void * data,
+      uint32_t count,
+      bool isArray,
+      std::string * errorOut = NULL
+      );
+
+    /// decodes JSON into data. data has to hold the current value(s), members
+    /// missing in the JSON keep their value. if isArray is true data is resized
+    /// to the number of elements in the JSON array, new elements are zeroed.
+    static bool decode(
+      const char * json,
+      TypeLayoutImplPtr layout,
+      std::vector<char> & data,
+      bool isArray,
+      std::string * errorOut = NULL
+      );
+
+    /// clears the cached encoding programs, f.e. after the layouts were cleared
+    static void clearCache();
+
+  private:
+
+    // one step of an encoding program, the literal text is emitted
+    // before the leaf (if leafIndex is >= 0)
+    struct Token
+    {
+      std::string literal;
+      int leafIndex;
+    };
+    typedef std::vector<Token> Program;
+    typedef boost::shared_ptr<Program> ProgramPtr;
+
+    static ProgramPtr getProgram(TypeLayoutImplPtr layout);
+    static void buildProgram(TypeLayoutImplPtr layout, Program & program);
+    // returns false for NaN and infinity, which JSON can't represent
+    static bool appendLeaf(std::string & json, TypeLayoutImpl::LeafType type, const char * data, char decimalPoint);
+
+    // the programs are shared, so that clearing the cache doesn't affect running encodes
+    static std::map<std::string, ProgramPtr> sPrograms;
+    static boost::mutex sProgramsMutex;
+  };
+};
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
 
 #include "KLParserImpl.h"
+#include "TypeLayoutImpl.h"
 
 #include <limits.h>
 #include <string.h>
@@ -427,16 +428,23 @@ KLParserImplPtr KLParserImpl::getParser(const char * owner, const char * name, c
     KLParserImpl * parser = new KLParserImpl(owner, name, klCode);
     KLParserImplPtr ptr(parser);
     sParsers.insert(std::pair<std::string, KLParserImplPtr>(key, ptr));
+
+    // the struct layouts are derived from the parsed KL code
+    TypeLayoutImpl::clearCache();
     return ptr;
   }
   if(klCode)
+  {
     it->second->parse(klCode);
+    TypeLayoutImpl::clearCache();
+  }
   return it->second;
 }
 
 void KLParserImpl::resetAll()
 {
   sParsers.clear();
+  TypeLayoutImpl::clearCache();
 }
 
 const KLParserImpl::KLSymbol * KLParserImpl::getKLSymbol(unsigned int symbolIndex) const
@@ -1246,6 +1254,23 @@ const char * KLParserImpl::getKLTypeForSymbol(const KLParserImpl::KLSymbol * s)
   return "";
 }
 
+const KLParserImpl::KLStruct * KLParserImpl::findKLStruct(const std::string & name)
+{
+  std::map<std::string, KLParserImplPtr>::iterator it = sParsers.begin();
+  for(;it!=sParsers.end();it++)
+  {
+    KLParserImplPtr parser = it->second;
+    if(!parser)
+      continue;
+    for(size_t i=0;i<parser->mParsedStructs.size();i++)
+    {
+      if(parser->mParsedStructs[i].name() == name)
+        return &parser->mParsedStructs[i];
+    }
+  }
+  return NULL;
+}
+
 const char * KLParserImpl::getKLTypeForMemberOrMethod(const std::string & owner, const std::string & member)
 {
   std::map<std::string, KLParserImplPtr>::iterator it = sParsers.begin();
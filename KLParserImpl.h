@@ -302,6 +302,9 @@ namespace FabricSpliceImpl
     const char * getKLTypeForSymbol(const KLSymbol * s) const;
     static const char * getKLTypeForMemberOrMethod(const std::string & owner, const std::string & member);
 
+    // returns the first parsed struct or object with the given name across all parsers
+    static const KLStruct * findKLStruct(const std::string & name);
+
   private:
     KLParserImpl(const char * owner, const char * name, const char * klCode);
     unsigned int getIndexOfKLSymbol(const KLSymbol * symbol) const;
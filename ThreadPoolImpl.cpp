@@ -0,0 +1,156 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "ThreadPoolImpl.h"
+
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/atomic.hpp>
+
+using namespace FabricSpliceImpl;
+
+static void noCleanup(bool *) {}
+
+// runs are serialized by sRunMutex, the task state below is guarded by sMutex.
+// the thread count is read without either, so that callers never wait for a run
+static boost::mutex sRunMutex;
+static boost::mutex sMutex;
+static boost::condition_variable sWakeCondition;
+static boost::condition_variable sDoneCondition;
+static std::vector<boost::thread *> sThreads;
+static boost::atomic<uint32_t> sThreadCount(0);
+static bool sStopping = false;
+static ThreadPoolImpl::TaskFunc sFunc = NULL;
+static void * sUserData = NULL;
+static uint32_t sTaskCount = 0;
+static uint32_t sNextTask = 0;
+static uint32_t sPendingTasks = 0;
+
+// set on threads currently executing tasks, to run nested runs inline
+static bool sTrue = true;
+static boost::thread_specific_ptr<bool> sInTask(noCleanup);
+
+// claims and executes tasks until none are left, expects sMutex to be locked
+static void executeTasks(boost::unique_lock<boost::mutex> & lock)
+{
+  while(sNextTask < sTaskCount)
+  {
+    uint32_t index = sNextTask++;
+    ThreadPoolImpl::TaskFunc func = sFunc;
+    void * userData = sUserData;
+    lock.unlock();
+    func(userData, index);
+    lock.lock();
+    if(--sPendingTasks == 0)
+      sDoneCondition.notify_all();
+  }
+}
+
+static void workerLoop()
+{
+  sInTask.reset(&sTrue);
+  boost::unique_lock<boost::mutex> lock(sMutex);
+  for(;;)
+  {
+    while(!sStopping && sNextTask >= sTaskCount)
+      sWakeCondition.wait(lock);
+    if(sStopping)
+      return;
+    executeTasks(lock);
+  }
+}
+
+static uint32_t resolveThreadCount()
+{
+  uint32_t threadCount = sThreadCount.load();
+  if(threadCount > 0)
+    return threadCount;
+  uint32_t count = boost::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+// expects sRunMutex to be locked
+static void stopThreads()
+{
+  {
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    sStopping = true;
+  }
+  sWakeCondition.notify_all();
+  for(size_t i=0;i<sThreads.size();i++)
+  {
+    sThreads[i]->join();
+    delete(sThreads[i]);
+  }
+  sThreads.clear();
+  sStopping = false;
+}
+
+void ThreadPoolImpl::setThreadCount(uint32_t threadCount)
+{
+  // surplus worker threads are stopped by the next run
+  sThreadCount.store(threadCount);
+}
+
+uint32_t ThreadPoolImpl::getThreadCount()
+{
+  return resolveThreadCount();
+}
+
+void ThreadPoolImpl::run(TaskFunc func, void * userData, uint32_t taskCount)
+{
+  if(taskCount == 0)
+    return;
+
+  if(taskCount == 1 || sInTask.get() != NULL)
+  {
+    for(uint32_t i=0;i<taskCount;i++)
+      func(userData, i);
+    return;
+  }
+
+  // while another thread's run is in flight, f.e. an asynchronous evaluation,
+  // the tasks are executed on the calling thread instead of waiting for it
+  boost::unique_lock<boost::mutex> runLock(sRunMutex, boost::try_to_lock);
+
+  uint32_t workerCount = runLock.owns_lock() ? resolveThreadCount() - 1 : 0;
+  if(workerCount == 0)
+  {
+    for(uint32_t i=0;i<taskCount;i++)
+      func(userData, i);
+    return;
+  }
+  if(sThreads.size() > workerCount)
+    stopThreads();
+  while(sThreads.size() < workerCount)
+    sThreads.push_back(new boost::thread(workerLoop));
+
+  sInTask.reset(&sTrue);
+  {
+    boost::unique_lock<boost::mutex> lock(sMutex);
+    sFunc = func;
+    sUserData = userData;
+    sNextTask = 0;
+    sTaskCount = taskCount;
+    sPendingTasks = taskCount;
+    sWakeCondition.notify_all();
+
+    executeTasks(lock);
+    while(sPendingTasks > 0)
+      sDoneCondition.wait(lock);
+
+    sFunc = NULL;
+    sUserData = NULL;
+    sNextTask = 0;
+    sTaskCount = 0;
+  }
+  sInTask.reset();
+}
+
+void ThreadPoolImpl::shutdown()
+{
+  boost::unique_lock<boost::mutex> runLock(sRunMutex);
+  stopThreads();
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_THREADPOOLIMPL_H__
+#define __FabricSpliceImpl_THREADPOOLIMPL_H__
+
+#include <stdint.h>
+
+namespace FabricSpliceImpl
+{
+  /// a small pool of host worker threads used to split large
+  /// IO work, such as bulk copies, into several tasks.
+  /// the worker threads are started lazily on the first run.
+  class ThreadPoolImpl
+  {
+  public:
+
+    /// a task function, called once for every index in [0, taskCount)
+    typedef void (*TaskFunc)(void * userData, uint32_t index);
+
+    /// sets the number of threads used per run, including the calling thread.
+    /// 0 uses the number of hardware threads. this doesn't wait for a run in flight,
+    /// the new count applies from the next run on.
+    static void setThreadCount(uint32_t threadCount);
+
+    /// returns the number of threads used per run, including the calling thread
+    static uint32_t getThreadCount();
+
+    /// runs func for all task indices and blocks until all of them are done.
+    /// the calling thread takes part in the work. runs are serialized, a run
+    /// issued from within a task or while another thread's run is in flight
+    /// is executed on the calling thread.
+    static void run(TaskFunc func, void * userData, uint32_t taskCount);
+
+    /// stops and joins all worker threads
+    static void shutdown();
+  };
+};
+
+#endif
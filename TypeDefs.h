@@ -19,6 +19,14 @@ namespace FabricSpliceImpl
   typedef boost::shared_ptr<DGPortImpl> DGPortImplPtr;
   typedef boost::weak_ptr<DGPortImpl> DGPortImplWeakPtr;
   typedef std::vector<DGPortImplPtr> DGPortImplPtrVector;
+  class DGPortIOPlanImpl;
+  typedef boost::shared_ptr<DGPortIOPlanImpl> DGPortIOPlanImplPtr;
+  class DGEvaluationImpl;
+  typedef boost::shared_ptr<DGEvaluationImpl> DGEvaluationImplPtr;
+  class TypeLayoutImpl;
+  typedef boost::shared_ptr<TypeLayoutImpl> TypeLayoutImplPtr;
+  class ColumnLayoutImpl;
+  typedef boost::shared_ptr<ColumnLayoutImpl> ColumnLayoutImplPtr;
 };
 
 #endif
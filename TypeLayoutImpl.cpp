@@ -0,0 +1,357 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "TypeLayoutImpl.h"
+#include "KLParserImpl.h"
+#include "JSONCodecImpl.h"
+#include "ColumnLayoutImpl.h"
+#include "DGGraphImpl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace FabricSpliceImpl;
+
+std::map<std::string, TypeLayoutImplPtr> TypeLayoutImpl::sLayouts;
+boost::mutex TypeLayoutImpl::sLayoutsMutex;
+uint32_t TypeLayoutImpl::sCacheGeneration = 0;
+
+// the member layout of the math types, which usually aren't
+// known to any of the KLParsers since they ship as extensions.
+static const char * sBuiltinStructs[][2] = {
+  {"Vec2", "Float32 x;Float32 y"},
+  {"Vec3", "Float32 x;Float32 y;Float32 z"},
+  {"Vec4", "Float32 x;Float32 y;Float32 z;Float32 t"},
+  {"Vec2_d", "Float64 x;Float64 y"},
+  {"Vec3_d", "Float64 x;Float64 y;Float64 z"},
+  {"Vec4_d", "Float64 x;Float64 y;Float64 z;Float64 t"},
+  {"Vec2_i", "SInt32 x;SInt32 y"},
+  {"Vec3_i", "SInt32 x;SInt32 y;SInt32 z"},
+  {"Vec4_i", "SInt32 x;SInt32 y;SInt32 z;SInt32 t"},
+  {"Quat", "Vec3 v;Float32 w"},
+  {"Quat_d", "Vec3_d v;Float64 w"},
+  {"Color", "Float32 r;Float32 g;Float32 b;Float32 a"},
+  {"RGB", "UInt8 r;UInt8 g;UInt8 b"},
+  {"RGBA", "UInt8 r;UInt8 g;UInt8 b;UInt8 a"},
+  {"Mat22", "Vec2 row0;Vec2 row1"},
+  {"Mat33", "Vec3 row0;Vec3 row1;Vec3 row2"},
+  {"Mat44", "Vec4 row0;Vec4 row1;Vec4 row2;Vec4 row3"},
+  {"Mat22_d", "Vec2_d row0;Vec2_d row1"},
+  {"Mat33_d", "Vec3_d row0;Vec3_d row1;Vec3_d row2"},
+  {"Mat44_d", "Vec4_d row0;Vec4_d row1;Vec4_d row2;Vec4_d row3"},
+  {"Xfo", "Quat ori;Vec3 tr;Vec3 sc"},
+  {"Box2", "Vec2 min;Vec2 max"},
+  {"Box3", "Vec3 min;Vec3 max"},
+  {NULL, NULL}
+};
+
+TypeLayoutImpl::TypeLayoutImpl(const std::string & dataType)
+{
+  mDataType = dataType;
+  mSize = 0;
+}
+
+TypeLayoutImplPtr TypeLayoutImpl::getLayout(const std::string & dataType, std::string * errorOut)
+{
+  boost::unique_lock<boost::mutex> lock(sLayoutsMutex);
+  std::map<std::string, TypeLayoutImplPtr>::iterator it = sLayouts.find(dataType);
+  if(it != sLayouts.end())
+    return it->second;
+
+  TypeLayoutImplPtr layout(new TypeLayoutImpl(dataType));
+  uint32_t offset = 0;
+  uint32_t alignment = 1;
+  if(!layout->appendType(dataType, "", offset, alignment, 0, errorOut))
+    return TypeLayoutImplPtr();
+  layout->mSize = offset;
+  layout->indexFields();
+
+  // the computed layout is only trusted if it matches the registered type
+  const FabricCore::Client * client = DGGraphImpl::getClient();
+  if(client)
+  {
+    try
+    {
+      uint32_t registeredSize = (uint32_t)FabricCore::GetRegisteredTypeSize(*client, dataType.c_str());
+      if(registeredSize != layout->mSize)
+      {
+        LoggingImpl::reportError("The layout of type '"+dataType+"' does not match its registered size.", errorOut);
+        return TypeLayoutImplPtr();
+      }
+    }
+    catch(FabricCore::Exception e)
+    {
+      LoggingImpl::reportError(e.getDesc_cstr(), errorOut);
+      return TypeLayoutImplPtr();
+    }
+  }
+
+  sLayouts.insert(std::pair<std::string, TypeLayoutImplPtr>(dataType, layout));
+  return layout;
+}
+
+void TypeLayoutImpl::clearCache()
+{
+  {
+    boost::unique_lock<boost::mutex> lock(sLayoutsMutex);
+    sLayouts.clear();
+    sCacheGeneration++;
+  }
+  JSONCodecImpl::clearCache();
+  ColumnLayoutImpl::clearCache();
+}
+
+uint32_t TypeLayoutImpl::getCacheGeneration()
+{
+  boost::unique_lock<boost::mutex> lock(sLayoutsMutex);
+  return sCacheGeneration;
+}
+
+uint32_t TypeLayoutImpl::getLeafTypeSize(LeafType type)
+{
+  switch(type)
+  {
+    case LeafType_Boolean:
+    case LeafType_UInt8:
+    case LeafType_SInt8:
+      return 1;
+    case LeafType_UInt16:
+    case LeafType_SInt16:
+      return 2;
+    case LeafType_UInt32:
+    case LeafType_SInt32:
+    case LeafType_Float32:
+      return 4;
+    case LeafType_UInt64:
+    case LeafType_SInt64:
+    case LeafType_Float64:
+      return 8;
+  }
+  return 0;
+}
+
+int TypeLayoutImpl::getLeafIndex(const std::string & path) const
+{
+  std::map<std::string, uint32_t>::const_iterator it = mLeafIndices.find(path);
+  if(it == mLeafIndices.end())
+    return -1;
+  return (int)it->second;
+}
+
+bool TypeLayoutImpl::getField(const std::string & path, uint32_t & offset, uint32_t & size) const
+{
+  std::map<std::string, Field>::const_iterator it = mFields.find(path);
+  if(it == mFields.end())
+    return false;
+  offset = it->second.offset;
+  size = it->second.size;
+  return true;
+}
+
+void TypeLayoutImpl::indexFields()
+{
+  // each field spans the leaves of all paths it is a prefix of
+  for(size_t i=0;i<mLeaves.size();i++)
+  {
+    const Leaf & leaf = mLeaves[i];
+    uint32_t leafEnd = leaf.offset + getLeafTypeSize(leaf.type);
+    for(size_t j=1;j<=leaf.path.length();j++)
+    {
+      if(j < leaf.path.length() && leaf.path[j] != '.' && leaf.path[j] != '[')
+        continue;
+      std::string path = leaf.path.substr(0, j);
+      std::map<std::string, Field>::iterator it = mFields.find(path);
+      if(it == mFields.end())
+      {
+        Field field;
+        field.offset = leaf.offset;
+        field.size = leafEnd - leaf.offset;
+        mFields.insert(std::pair<std::string, Field>(path, field));
+        continue;
+      }
+      uint32_t fieldEnd = it->second.offset + it->second.size;
+      if(leaf.offset < it->second.offset)
+        it->second.offset = leaf.offset;
+      if(leafEnd > fieldEnd)
+        fieldEnd = leafEnd;
+      it->second.size = fieldEnd - it->second.offset;
+    }
+  }
+}
+
+bool TypeLayoutImpl::isHomogeneous(LeafType type) const
+{
+  uint32_t leafSize = getLeafTypeSize(type);
+  if(mLeaves.size() * leafSize != mSize)
+    return false;
+  for(size_t i=0;i<mLeaves.size();i++)
+  {
+    if(mLeaves[i].type != type)
+      return false;
+  }
+  return true;
+}
+
+bool TypeLayoutImpl::appendType(const std::string & dataType, const std::string & prefix, uint32_t & offset, uint32_t & alignment, int depth, std::string * errorOut)
+{
+  if(depth > 32)
+    return LoggingImpl::reportError("Type '"+mDataType+"' is nested too deeply.", errorOut);
+
+  // fixed size arrays, like Float32[3]
+  std::string baseType = dataType;
+  uint32_t fixedCount = 0;
+  if(StringUtilityImpl::endsWith(baseType, "]"))
+  {
+    size_t bracket = baseType.rfind('[');
+    std::string countStr;
+    if(bracket != std::string::npos)
+      countStr = baseType.substr(bracket + 1, baseType.length() - bracket - 2);
+    if(countStr.length() == 0 || countStr.find_first_not_of("0123456789") != std::string::npos)
+      return LoggingImpl::reportError("Type '"+mDataType+"' contains a non fixed size array member.", errorOut);
+    fixedCount = (uint32_t)atoi(countStr.c_str());
+    baseType = baseType.substr(0, bracket);
+  }
+
+  if(fixedCount > 0)
+  {
+    for(uint32_t i=0;i<fixedCount;i++)
+    {
+      char indexStr[32];
+      sprintf(indexStr, "[%u]", i);
+      if(!appendType(baseType, prefix + indexStr, offset, alignment, depth + 1, errorOut))
+        return false;
+    }
+    return true;
+  }
+
+  LeafType leafType;
+  if(getLeafType(baseType, leafType))
+  {
+    uint32_t leafSize = getLeafTypeSize(leafType);
+    offset = (offset + leafSize - 1) / leafSize * leafSize;
+    if(leafSize > alignment)
+      alignment = leafSize;
+
+    Leaf leaf;
+    leaf.path = prefix;
+    leaf.type = leafType;
+    leaf.offset = offset;
+    mLeafIndices.insert(std::pair<std::string, uint32_t>(prefix, (uint32_t)mLeaves.size()));
+    mLeaves.push_back(leaf);
+    offset += leafSize;
+    return true;
+  }
+
+  stringVector memberTypes;
+  stringVector memberNames;
+  if(!getStructMembers(baseType, memberTypes, memberNames))
+    return LoggingImpl::reportError("The layout of type '"+baseType+"' is unknown.", errorOut);
+
+  // members are laid out relative to the start of the struct first, structs
+  // are aligned to their largest member and padded to that alignment
+  size_t firstLeaf = mLeaves.size();
+  uint32_t structAlignment = 1;
+  uint32_t structOffset = 0;
+  for(size_t i=0;i<memberTypes.size();i++)
+  {
+    std::string memberPath = prefix.length() > 0 ? prefix + "." + memberNames[i] : memberNames[i];
+    if(!appendType(memberTypes[i], memberPath, structOffset, structAlignment, depth + 1, errorOut))
+      return false;
+  }
+  structOffset = (structOffset + structAlignment - 1) / structAlignment * structAlignment;
+
+  offset = (offset + structAlignment - 1) / structAlignment * structAlignment;
+  for(size_t i=firstLeaf;i<mLeaves.size();i++)
+    mLeaves[i].offset += offset;
+
+  offset += structOffset;
+  if(structAlignment > alignment)
+    alignment = structAlignment;
+  return true;
+}
+
+bool TypeLayoutImpl::getLeafType(const std::string & dataType, LeafType & type)
+{
+  if(dataType == "Boolean")
+    type = LeafType_Boolean;
+  else if(dataType == "UInt8" || dataType == "Byte")
+    type = LeafType_UInt8;
+  else if(dataType == "SInt8")
+    type = LeafType_SInt8;
+  else if(dataType == "UInt16")
+    type = LeafType_UInt16;
+  else if(dataType == "SInt16")
+    type = LeafType_SInt16;
+  else if(dataType == "UInt32")
+    type = LeafType_UInt32;
+  else if(dataType == "SInt32" || dataType == "Integer")
+    type = LeafType_SInt32;
+  else if(dataType == "UInt64")
+    type = LeafType_UInt64;
+  else if(dataType == "SInt64")
+    type = LeafType_SInt64;
+  else if(dataType == "Float32" || dataType == "Scalar")
+    type = LeafType_Float32;
+  else if(dataType == "Float64")
+    type = LeafType_Float64;
+  else if(dataType == "Size" || dataType == "Index" || dataType == "Count")
+  {
+    // pointer sized integers
+    type = LeafType_UInt64;
+    const FabricCore::Client * client = DGGraphImpl::getClient();
+    if(client)
+    {
+      try
+      {
+        if(FabricCore::GetRegisteredTypeSize(*client, dataType.c_str()) == 4)
+          type = LeafType_UInt32;
+      }
+      catch(FabricCore::Exception e)
+      {
+        return false;
+      }
+    }
+  }
+  else
+    return false;
+  return true;
+}
+
+bool TypeLayoutImpl::getStructMembers(const std::string & dataType, stringVector & memberTypes, stringVector & memberNames, bool includeObjects)
+{
+  for(size_t i=0;sBuiltinStructs[i][0] != NULL;i++)
+  {
+    if(dataType != sBuiltinStructs[i][0])
+      continue;
+    stringVector members = StringUtilityImpl::splitString(sBuiltinStructs[i][1], ';');
+    for(size_t j=0;j<members.size();j++)
+    {
+      stringVector parts = StringUtilityImpl::splitString(members[j], ' ');
+      memberTypes.push_back(parts[0]);
+      memberNames.push_back(parts[1]);
+    }
+    return true;
+  }
+
+  const KLParserImpl::KLStruct * klStruct = KLParserImpl::findKLStruct(dataType);
+  if(klStruct == NULL)
+    return false;
+  std::string klType = klStruct->type();
+  if(klType != "struct" && !(includeObjects && klType == "object"))
+    return false;
+
+  for(unsigned int i=0;i<klStruct->nbMembers();i++)
+  {
+    // the parser folds 'Float32 a, b;' into the type 'Float32,b'
+    stringVector parts = StringUtilityImpl::splitString(klStruct->memberType(i), ',', true);
+    if(parts.size() == 0)
+      return false;
+    memberTypes.push_back(parts[0]);
+    memberNames.push_back(klStruct->memberName(i));
+    for(size_t j=1;j<parts.size();j++)
+    {
+      memberTypes.push_back(parts[0]);
+      memberNames.push_back(parts[j]);
+    }
+  }
+  return memberTypes.size() > 0;
+}
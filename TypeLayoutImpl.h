@@ -0,0 +1,109 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __FabricSpliceImpl_TYPELAYOUTIMPL_H__
+#define __FabricSpliceImpl_TYPELAYOUTIMPL_H__
+
+#include "LoggingImpl.h"
+#include "TypeDefs.h"
+#include <FabricCore.h>
+
+#include <boost/thread/mutex.hpp>
+
+namespace FabricSpliceImpl
+{
+  /// describes the memory layout of a shallow KL type as a flat list of
+  /// scalar leaves, each with a path (like "tr.x") and a byte offset.
+  class TypeLayoutImpl
+  {
+  public:
+
+    enum LeafType
+    {
+      LeafType_Boolean,
+      LeafType_UInt8,
+      LeafType_SInt8,
+      LeafType_UInt16,
+      LeafType_SInt16,
+      LeafType_UInt32,
+      LeafType_SInt32,
+      LeafType_UInt64,
+      LeafType_SInt64,
+      LeafType_Float32,
+      LeafType_Float64
+    };
+
+    struct Leaf
+    {
+      std::string path;
+      LeafType type;
+      uint32_t offset;
+    };
+
+    /// returns the layout for a given data type, or an empty pointer if the
+    /// layout can't be determined. layouts are cached per data type.
+    static TypeLayoutImplPtr getLayout(const std::string & dataType, std::string * errorOut = NULL);
+
+    /// clears the layout cache, f.e. after KL code has been reparsed.
+    /// this also clears the JSONCodecImpl and ColumnLayoutImpl caches.
+    static void clearCache();
+
+    /// returns a counter which is increased by every clearCache, so that
+    /// layouts held outside of the cache can be dropped once they are stale
+    static uint32_t getCacheGeneration();
+
+    /// returns the byte size of a single leaf of the given type
+    static uint32_t getLeafTypeSize(LeafType type);
+
+    /// returns the data type this layout describes
+    char const * getDataType() const { return mDataType.c_str(); }
+
+    /// returns the byte size of the data type
+    uint32_t getSize() const { return mSize; }
+
+    /// returns the number of scalar leaves
+    uint32_t getLeafCount() const { return (uint32_t)mLeaves.size(); }
+
+    /// returns a leaf by index
+    const Leaf & getLeaf(uint32_t index) const { return mLeaves[index]; }
+
+    /// returns the index of the leaf with the given path, or -1
+    int getLeafIndex(const std::string & path) const;
+
+    /// returns the byte offset and size of a field, which is either a leaf or
+    /// a struct member / fixed array element containing leaves (like "tr" or "ori.v")
+    bool getField(const std::string & path, uint32_t & offset, uint32_t & size) const;
+
+    /// returns true if all leaves share the given type and are tightly packed
+    bool isHomogeneous(LeafType type) const;
+
+    /// returns the members of a struct type (or object type if includeObjects is true),
+    /// based on the math types and the structs known to the KLParsers
+    static bool getStructMembers(const std::string & dataType, stringVector & memberTypes, stringVector & memberNames, bool includeObjects = false);
+
+  private:
+
+    TypeLayoutImpl(const std::string & dataType);
+
+    bool appendType(const std::string & dataType, const std::string & prefix, uint32_t & offset, uint32_t & alignment, int depth, std::string * errorOut);
+    static bool getLeafType(const std::string & dataType, LeafType & type);
+    void indexFields();
+
+    std::string mDataType;
+    uint32_t mSize;
+    std::vector<Leaf> mLeaves;
+    std::map<std::string, uint32_t> mLeafIndices;
+
+    struct Field
+    {
+      uint32_t offset;
+      uint32_t size;
+    };
+    std::map<std::string, Field> mFields;
+
+    static std::map<std::string, TypeLayoutImplPtr> sLayouts;
+    static boost::mutex sLayoutsMutex;
+    static uint32_t sCacheGeneration;
+  };
+};
+
+#endif
@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+#include <FabricSplice.h>
+#include <vector>
+
+using namespace FabricSplice;
+
+int main( int argc, const char* argv[] )
+{
+  Initialize();
+
+  // enable timers
+  Logging::enableTimers();
+
+  // create a graph with a single Xfo and a Vec3 array
+  DGGraph graph = DGGraph("myGraph");
+  graph.constructDGNode();
+  graph.addDGNodeMember("xfo", "Xfo");
+  graph.addDGNodeMember("points", "Vec3[]");
+  DGPort xfo = graph.addDGPort("xfo", "xfo", Port_Mode_IO);
+  DGPort points = graph.addDGPort("points", "points", Port_Mode_IO);
+
+  std::vector<float> values(3 * 10000);
+  for(size_t i=0;i<values.size();i++)
+    values[i] = float(i) * 0.25f;
+  points.setArrayData(&values[0], sizeof(float) * values.size());
+
+  const unsigned int iterations = 1000;
+  std::string xfoJSON = xfo.getJSON();
+  std::string pointsJSON = points.getJSON();
+
+  // shallow ports encode and decode JSON straight from / into the member
+  {
+    Logging::AutoTimer timer("xfo json direct");
+    for(unsigned int i=0;i<iterations;i++)
+    {
+      xfo.setJSON(xfoJSON.c_str());
+      xfoJSON = xfo.getJSON();
+    }
+  }
+
+  // the same round trip through a FabricCore::Variant, which is what the
+  // ports used to do. DGPort::setVariant patches dictionaries for structs,
+  // so the DGNode is used directly to measure the plain Variant IO.
+  FabricCore::DGNode dgNode = graph.getDGNode("");
+  {
+    Logging::AutoTimer timer("xfo json variant");
+    for(unsigned int i=0;i<iterations;i++)
+    {
+      dgNode.setMemberSliceData_Variant("xfo", 0, FabricCore::Variant::CreateFromJSON(xfoJSON.c_str()));
+      xfoJSON = dgNode.getMemberSliceData_Variant("xfo", 0).getJSONEncoding().getStringData();
+    }
+  }
+
+  {
+    Logging::AutoTimer timer("points json direct");
+    for(unsigned int i=0;i<iterations / 100;i++)
+    {
+      points.setJSON(pointsJSON.c_str());
+      pointsJSON = points.getJSON();
+    }
+  }
+
+  {
+    Logging::AutoTimer timer("points json variant");
+    for(unsigned int i=0;i<iterations / 100;i++)
+    {
+      dgNode.setMemberSliceData_Variant("points", 0, FabricCore::Variant::CreateFromJSON(pointsJSON.c_str()));
+      pointsJSON = dgNode.getMemberSliceData_Variant("points", 0).getJSONEncoding().getStringData();
+    }
+  }
+
+  // report all timers
+  for(unsigned int i=0;i<Logging::getNbTimers();i++)
+  {
+    Logging::logTimer(Logging::getTimerName(i));
+  }
+
+  Finalize();
+  return 0;
+}
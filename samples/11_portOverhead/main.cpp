@@ -0,0 +1,70 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+#include <FabricSplice.h>
+
+using namespace FabricSplice;
+
+int main( int argc, const char* argv[] )
+{
+  Initialize();
+
+  // enable timers
+  Logging::enableTimers();
+
+  // create a graph with a scalar and a small array port
+  DGGraph graph = DGGraph("myGraph");
+  graph.constructDGNode();
+  graph.addDGNodeMember("value", "Scalar");
+  graph.addDGNodeMember("values", "Scalar[]");
+  DGPort value = graph.addDGPort("value", "value", Port_Mode_IO);
+  DGPort values = graph.addDGPort("values", "values", Port_Mode_IO);
+
+  const unsigned int iterations = 1000000;
+  float scalar = 0.0f;
+  float array[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+
+  // these calls are only made of API which existed before the ports resolved
+  // their graph through the registry slot, so the sample builds against older
+  // SpliceAPI versions as well for comparing the per-call cost. build it in
+  // release, debug builds count the calls in flight on every port call.
+  {
+    Logging::AutoTimer timer("getSliceCount");
+    for(unsigned int i=0;i<iterations;i++)
+      value.getSliceCount();
+  }
+
+  {
+    Logging::AutoTimer timer("setAllSlicesData");
+    for(unsigned int i=0;i<iterations;i++)
+    {
+      scalar = float(i);
+      value.setAllSlicesData(&scalar, sizeof(float));
+    }
+  }
+
+  {
+    Logging::AutoTimer timer("getAllSlicesData");
+    for(unsigned int i=0;i<iterations;i++)
+      value.getAllSlicesData(&scalar, sizeof(float));
+  }
+
+  {
+    Logging::AutoTimer timer("setArrayData");
+    for(unsigned int i=0;i<iterations;i++)
+      values.setArrayData(array, sizeof(array));
+  }
+
+  {
+    Logging::AutoTimer timer("getArrayData");
+    for(unsigned int i=0;i<iterations;i++)
+      values.getArrayData(array, sizeof(array));
+  }
+
+  // report all timers
+  for(unsigned int i=0;i<Logging::getNbTimers();i++)
+  {
+    Logging::logTimer(Logging::getTimerName(i));
+  }
+
+  Finalize();
+  return 0;
+}
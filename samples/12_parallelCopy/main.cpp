@@ -0,0 +1,62 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+#include <FabricSplice.h>
+#include <vector>
+
+using namespace FabricSplice;
+
+int main( int argc, const char* argv[] )
+{
+  Initialize();
+
+  // enable timers
+  Logging::enableTimers();
+
+  // create a graph with a large Vec3 array port, 256MB of data
+  DGGraph graph = DGGraph("myGraph");
+  graph.constructDGNode();
+  graph.addDGNodeMember("positions", "Vec3[]");
+  DGPort positions = graph.addDGPort("positions", "positions", Port_Mode_IO);
+
+  const unsigned int count = 256 * 1024 * 1024 / 12;
+  const unsigned int iterations = 10;
+  std::vector<float> buffer(count * 3, 1.0f);
+  positions.setArrayData(&buffer[0], count * 12);
+
+  // the whole array is copied by FabricCore, regardless of the parallel copy
+  {
+    Logging::AutoTimer timer("getArrayData");
+    for(unsigned int i=0;i<iterations;i++)
+      positions.getArrayData(&buffer[0], count * 12);
+  }
+
+  // the same range read, before and after enabling the parallel copy
+  {
+    Logging::AutoTimer timer("getArrayDataRange serial");
+    for(unsigned int i=0;i<iterations;i++)
+      positions.getArrayDataRange(&buffer[0], 0, count);
+  }
+
+  SetParallelCopy(true);
+  {
+    Logging::AutoTimer timer("getArrayDataRange parallel");
+    for(unsigned int i=0;i<iterations;i++)
+      positions.getArrayDataRange(&buffer[0], 0, count);
+  }
+
+  SetParallelCopy(true, 0, 16777216, true);
+  {
+    Logging::AutoTimer timer("getArrayDataRange parallel non temporal");
+    for(unsigned int i=0;i<iterations;i++)
+      positions.getArrayDataRange(&buffer[0], 0, count);
+  }
+  SetParallelCopy(false);
+
+  // report all timers
+  for(unsigned int i=0;i<Logging::getNbTimers();i++)
+  {
+    Logging::logTimer(Logging::getTimerName(i));
+  }
+
+  Finalize();
+  return 0;
+}
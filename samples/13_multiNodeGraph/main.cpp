@@ -0,0 +1,92 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+#include <FabricSplice.h>
+
+using namespace FabricSplice;
+
+void printOperators(DGGraph & graph, const char * dgNodeName)
+{
+  for(unsigned int i=0;i<graph.getKLOperatorCount(dgNodeName);i++)
+    printf("%s operator %d: %s\n", dgNodeName, i, graph.getKLOperatorName(i, dgNodeName));
+}
+
+int main( int argc, const char* argv[] )
+{
+  std::string klCode;
+
+  Initialize();
+
+  // create a graph with two independent branches,
+  // which are combined by the default DGNode
+  DGGraph graph = DGGraph("myGraph");
+  graph.constructDGNode();
+  graph.constructDGNode("branchA");
+  graph.constructDGNode("branchB");
+  graph.setDGNodeDependency("DGNode", "branchA");
+  graph.setDGNodeDependency("DGNode", "branchB");
+
+  // create some members
+  graph.addDGNodeMember("result", "Scalar");
+  graph.addDGNodeMember("inA", "Scalar", FabricCore::Variant(), "branchA");
+  graph.addDGNodeMember("outA", "Scalar", FabricCore::Variant(), "branchA");
+  graph.addDGNodeMember("inB", "Scalar", FabricCore::Variant(), "branchB");
+  graph.addDGNodeMember("outB", "Scalar", FabricCore::Variant(), "branchB");
+
+  // create ports to the members
+  DGPort result = graph.addDGPort("result", "result", Port_Mode_IO);
+  DGPort inA = graph.addDGPort("inA", "inA", Port_Mode_IN, "branchA");
+  graph.addDGPort("outA", "outA", Port_Mode_IO, "branchA");
+  DGPort inB = graph.addDGPort("inB", "inB", Port_Mode_IN, "branchB");
+  graph.addDGPort("outB", "outB", Port_Mode_IO, "branchB");
+
+  // stack two operators on the first branch, their order matters
+  klCode = "operator scaleA(Scalar inA, io Scalar outA) {\n";
+  klCode += "  outA = inA * 2.0;\n";
+  klCode += "}\n";
+  graph.constructKLOperator("scaleA", klCode.c_str(), "scaleA", "branchA");
+
+  klCode = "operator offsetA(io Scalar outA) {\n";
+  klCode += "  outA += 1.0;\n";
+  klCode += "}\n";
+  graph.constructKLOperator("offsetA", klCode.c_str(), "offsetA", "branchA");
+
+  klCode = "operator scaleB(Scalar inB, io Scalar outB) {\n";
+  klCode += "  outB = inB * 3.0;\n";
+  klCode += "}\n";
+  graph.constructKLOperator("scaleB", klCode.c_str(), "scaleB", "branchB");
+
+  klCode = "operator combine(Scalar outA, Scalar outB, io Scalar result) {\n";
+  klCode += "  result = outA + outB;\n";
+  klCode += "}\n";
+  graph.constructKLOperator("combine", klCode.c_str());
+
+  // feed in some data and perform, the branches don't depend on each
+  // other, so they are evaluated on the same level before the default DGNode
+  inA.setVariant(FabricCore::Variant::CreateFloat32(1.0));
+  inB.setVariant(FabricCore::Variant::CreateFloat32(2.0));
+  float before = result.get<float>();
+  printf("Result: %f\n", before);
+
+  // move the offset in front of the scale on the first branch, the
+  // operators on the other DGNodes keep their place. the scale now
+  // overwrites the offset, so the result has to change
+  graph.setKLOperatorIndex("offsetA", 0);
+  printOperators(graph, "branchA");
+  printOperators(graph, "branchB");
+  printOperators(graph, "DGNode");
+  float after = result.get<float>();
+  printf("Result: %f\n", after);
+  if(after == before)
+  {
+    printf("Error: Reordering the operators didn't change the result.\n");
+    Finalize();
+    return 1;
+  }
+
+  // evaluating shared lets the branches run in parallel
+  graph.setEvaluateShared(true);
+  inB.setVariant(FabricCore::Variant::CreateFloat32(3.0));
+  printf("Result: %f\n", result.get<float>());
+
+  Finalize();
+  return 0;
+}